@@ -21,6 +21,8 @@
 #include "vplAffineMatrix.h"
 #include "vplArray.h"
 #include "vplConfig.h"
+#include "vplCpu.h"
+#include "vplKernels.h"
 #include "vplList.h"
 #include "vplLog.h"
 #include "vplMap.h"
@@ -30,6 +32,7 @@
 #include "vplRedBlackTree.h"
 #include "vplString.h"
 #include "vplStroke.h"
+#include "vplThread.h"
 #include "vplVector.h"
 
 #endif // VPL_H_INCLUDED_
@@ -71,6 +71,9 @@ namespace vpl
         //Compute the determinant
         float computeDeterminant();
 
+        //Largest factor a vector is stretched by, translation is ignored
+        float computeMaxScale() const;
+
         //Transform vector(s)
         void transform(Vector& vector) const;
         void transform(const Vector& vector,Vector& result) const;
@@ -81,6 +84,8 @@ namespace vpl
         //Operators
          const AffineMatrix& operator *= (const AffineMatrix& m);
          AffineMatrix        operator *  (const AffineMatrix& m);
+         bool                operator == (const AffineMatrix& m) const;
+         bool                operator != (const AffineMatrix& m) const;
 
     protected:
 
@@ -117,6 +117,35 @@ namespace vpl
                 memory_->getAt(itemCount_ - 1) = item;
         }
 
+        // Add count items at once, they must not be in this array
+        inline void add(const T* items,vplUint count)
+        {
+            if(itemCount_ + count > memory_->getSize())
+                grow(itemCount_ + count);
+
+            DynamicMemory<T>::copy(memory_->getMemory() + itemCount_,items,count);
+
+            itemCount_ += count;
+        }
+
+        // Make room for count items so adding up to that many never
+        // reallocates. Grows like add, so reserving a little more before
+        // every add stays linear
+        inline void reserve(vplUint count)
+        {
+            if(count > memory_->getSize())
+                grow(count);
+        }
+
+        // Set the number of items, new items are left as the storage
+        // holds them
+        inline void resize(vplUint count)
+        {
+            reserve(count);
+
+            itemCount_ = count;
+        }
+
         // Align
         inline void align(Alignment alignment)
         {
@@ -125,6 +154,17 @@ namespace vpl
 
     private:
 
+        // Double the size, or more if that is not enough
+        void grow(vplUint count)
+        {
+            vplUint size = memory_->getSize()*2;
+
+            if(size < count)
+                size = count;
+
+            memory_->reAllocate(size);
+        }
+
         vplUint itemCount_;
         DynamicMemory<T>* memory_;
     };
@@ -0,0 +1,81 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>>
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#ifndef VPL_CONFIG_H_INCLUDED_
+#define VPL_CONFIG_H_INCLUDED_
+
+#define HAVE_STDINT_H
+#define HAVE_X86_KERNELS_
+
+// Standard MS dll immport/export stuff
+#ifdef _MSC_VER
+    #ifdef VPL_BUILDING_DLL
+        #define VPL_API __declspec(dllexport)
+    #else
+    #ifdef VPL_BUILDING_STATIC_LIB
+        #define VPL_API
+    #else
+        #define VPL_API __declspec(dllimport)
+    #endif
+#endif
+
+#else
+    #define VPL_API
+#endif //_MSC_VER
+
+// Standard int stuff
+#include <cstddef>
+
+#ifdef HAVE_STDINT_H
+
+#include <stdint.h>
+typedef int8_t vplInt8;
+typedef int16_t vplInt16;
+typedef int32_t vplInt32;
+typedef int64_t vplInt64;
+typedef uint8_t vplUint8;
+typedef uint16_t vplUint16;
+typedef uint32_t vplUint32;
+typedef uint64_t vplUint64;
+typedef ptrdiff_t vplPtrDiff;
+typedef uintptr_t vplPtr;
+
+#else // HAVE_STDINT_H
+
+#ifdef _MSC_VER
+#include <BaseTsd.h>
+typedef signed char vplInt8;
+typedef signed short vplInt16;
+typedef signed __int32 vplInt32;
+typedef signed __int64 vplInt64;
+typedef unsigned char vplUint8;
+typedef unsigned short vplUint16;
+typedef unsigned __int32 vplUint32;
+typedef unsigned __int64 vplUint64;
+typedef ptrdiff_t  vplPtrDiff;
+typedef UINT_PTR vplPtr;
+
+#endif // _MSC_VER
+
+#endif // HAVE_STDINT_H
+
+typedef unsigned int  vplUint;
+typedef unsigned char vplUchar;
+
+#endif // VPL_CONFIG_H_INCLUDED_
+
+
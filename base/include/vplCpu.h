@@ -0,0 +1,40 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VPL_CPU_H_INCLUDED_
+#define VPL_CPU_H_INCLUDED_
+
+#include "vplConfig.h"
+
+namespace vpl
+{
+    // Instruction set extensions that optimized code can use
+    enum CpuFeature
+    {
+        cCpuSSE2   = 1 << 0,
+        cCpuSSE41  = 1 << 1,
+        cCpuPopcnt = 1 << 2,
+        cCpuAVX2   = 1 << 3,
+        // AVX-512 foundation and byte/word instructions
+        cCpuAVX512 = 1 << 4
+    };
+
+    // Return the features supported by both processor and operating system
+    VPL_API vplUint32 getCpuFeatures();
+}
+#endif
@@ -0,0 +1,56 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VPL_KERNELS_H_INCLUDED_
+#define VPL_KERNELS_H_INCLUDED_
+
+#include "vplConfig.h"
+
+namespace vpl
+{
+    // Fill count values, count is at least one
+    typedef void (*MemFillKernel)(vplUint32* dest,vplUint32 value,vplUint count);
+
+    // Squared distances of the control points of a cubic bezier
+    // (from, control1, control2, to as x,y pairs) from the chord
+    typedef void (*FlatnessKernel)(const float* bezier,float* deltas);
+
+    // Transform numVectors x,y pairs in place by an affine matrix laid
+    // out as AffineMatrix stores it
+    typedef void (*TransformKernel)(const float* transform,float* vectors,
+                                    vplUint numVectors);
+
+    struct Kernels
+    {
+        MemFillKernel memFill32_;
+        FlatnessKernel estimateFlatness_;
+        TransformKernel batchTransform_;
+        // Same as batchTransform_ for matrices without shear
+        TransformKernel batchScaleTranslate_;
+    };
+
+    // Kernels for the instruction sets of this processor, chosen at startup
+    VPL_API const Kernels& getKernels();
+
+#ifdef HAVE_X86_KERNELS_
+    void setKernelsSSE2(Kernels& kernels);
+    void setKernelsAVX2(Kernels& kernels);
+    void setKernelsAVX512(Kernels& kernels);
+#endif
+}
+#endif
@@ -18,7 +18,11 @@
 #ifndef VPL_MEMORY_H_INCLUDED_
 #define VPL_MEMORY_H_INCLUDED_
 
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include "vplConfig.h"
+#include "vplKernels.h"
 
 #if defined(_MSC_VER)
     #define MEM_ALIGN(declaration, alignment) __declspec(align(alignment)) declaration
@@ -74,54 +78,19 @@ namespace vpl
 	}
 
     // Specialized version of memfill for 32 bit unsigned integers
-    // Used in blendroutines, might be SSE2 accelerated
-    #ifdef USE_SSE2_
-
-	extern "C" void PRE_CDECL_ memFill32SSE2(vplUint32* dest,
-											 const vplUint32* value,
-										     vplUint count) POST_CDECL_;
-
+    // Used in blendroutines, vectorized where the processor allows it
 	inline void vplMemFill32(vplUint32* dest,const vplUint32 value,vplUint count)
 	{
-		// Simplifies code
-		if (count < 7) 
+		// Not worth a call for short spans
+		if(count < 8)
 		{
-			switch (count) 
-			{
-				case 6: *dest++ = value;
-				case 5: *dest++ = value;
-				case 4: *dest++ = value;
-				case 3: *dest++ = value;
-				case 2: *dest++ = value;
-				case 1: *dest   = value;
-			}
-
-			return;
+			for(vplUint i = 0; i < count; i++)
+				dest[i] = value;
 		}
-
-		// Align destination
-		vplUint align = (vplPtr)(dest) & 0xf;
-
-		switch(align)
-		{
-			case 4:  *dest++ = value; --count;
-			case 8:  *dest++ = value; --count;
-			case 12: *dest++ = value; --count;
-		}
-
-		// Call optimized version
-		memFill32SSE2(dest,&value,count);
+		else
+			getKernels().memFill32_(dest,value,count);
 	}
 
-	#else
-
-	inline void vplMemFill32(vplUint32* src,const vplUint32 value,vplUint count)
-	{
-		vplMemFill(src,value,count);
-	}
-
-	#endif
-
 	enum Alignment
 	{
 		cNoAlignment  = 0,
@@ -131,6 +100,20 @@ namespace vpl
 		cAlign64      = 64
 	};
 
+    // Types that can be copied with memcpy and need no destructor.
+    // Compilers without the builtin take the constructing path
+    template<typename T> struct IsTriviallyCopyable
+    {
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5) || \
+    (defined(_MSC_VER) && _MSC_VER >= 1900)
+        static const bool cValue = __is_trivially_copyable(T);
+#else
+        static const bool cValue = false;
+#endif
+    };
+
+    // Trivially copyable types are kept in uninitialized storage that
+    // grows with realloc, others are constructed with new
     template<typename T> class DynamicMemory
     {
     public:
@@ -139,11 +122,11 @@ namespace vpl
 
 		DynamicMemory():size_(cInitialDynamicMemorySize),alignment_(0)
         {
-            data_ = alignedData_ = new T[size_];
+            data_ = alignedData_ = allocate(size_);
         }
         DynamicMemory(vplUint size):size_(size),alignment_(0)
         {
-            data_ = alignedData_ = new T[size_];
+            data_ = alignedData_ = allocate(size_);
         }
         DynamicMemory(vplUint size,Alignment alignment):size_(size),
 										                alignment_(alignment - 1),
@@ -156,7 +139,7 @@ namespace vpl
         ~DynamicMemory()
         {
 
-			delete [] data_;
+			release(data_);
 
 			alignedData_ = data_ = 0;
         }
@@ -216,26 +199,36 @@ namespace vpl
             // Reallocate data with alignment
             if(alignment_ )
             {
-                T* newData        = new T[size_ + alignment_];
+                T* newData        = allocate(size_ + alignment_);
                 T* newAlignedData = (T*)(vplPtrDiff(newData + alignment_) & ~alignment_);
 
 				if(newSize > oldSize)
-					vplMemCopy(newAlignedData,alignedData_,oldSize);
+					copy(newAlignedData,alignedData_,oldSize);
 
-                delete [] data_;
+                release(data_);
 
                 data_        = newData;
                 alignedData_ = newAlignedData;
             }
-            // Or without alignment
+            // Or without alignment, realloc can often grow in place
+            else if(IsTriviallyCopyable<T>::cValue)
+            {
+                void* newData = std::realloc(static_cast<void*>(data_),
+                                             size_ ? size_*sizeof(T) : 1);
+
+                if(!newData)
+                    throw std::bad_alloc();
+
+                data_ = alignedData_ = static_cast<T*>(newData);
+            }
             else
             {
-                T* newData = new T[size_];
+                T* newData = allocate(size_);
 
 				if(newSize > oldSize)
-					vplMemCopy(newData,data_,oldSize);
+					copy(newData,data_,oldSize);
 
-                delete [] data_;
+                release(data_);
 
                 data_ = alignedData_ = newData;
             }
@@ -251,7 +244,7 @@ namespace vpl
 		inline void clearAndResize(vplUint newSize)
         {
 			if(data_)
-				delete [] data_;
+				release(data_);
 
             alignedData_ = data_ = 0;
             size_ = newSize;
@@ -259,18 +252,48 @@ namespace vpl
             if(alignment_)
                 align();
             else
-                data_ = alignedData_ = new T[size_];
+                data_ = alignedData_ = allocate(size_);
+        }
+
+        // Copy count items, with memcpy when the type allows it
+        static inline void copy(T* dest,const T* src,vplUint count)
+        {
+            if(IsTriviallyCopyable<T>::cValue)
+                std::memcpy(static_cast<void*>(dest),src,count*sizeof(T));
+            else if(count)
+                vplMemCopy(dest,src,count);
         }
 
     private:
 
+        static inline T* allocate(vplUint count)
+        {
+            if(!IsTriviallyCopyable<T>::cValue)
+                return new T[count];
+
+            void* data = std::malloc(count ? count*sizeof(T) : 1);
+
+            if(!data)
+                throw std::bad_alloc();
+
+            return static_cast<T*>(data);
+        }
+
+        static inline void release(T* data)
+        {
+            if(IsTriviallyCopyable<T>::cValue)
+                std::free(static_cast<void*>(data));
+            else
+                delete [] data;
+        }
+
         void align()
         {
-            T* newData        = new T[size_ + alignment_];
+            T* newData        = allocate(size_ + alignment_);
             T* newAlignedData = (T*)(vplPtrDiff(newData + alignment_) & ~alignment_);
 
             if(data_)
-                delete [] data_;
+                release(data_);
 
             data_ = newData;
             alignedData_ = newAlignedData;
@@ -83,6 +83,15 @@ namespace vpl
             cLargeClockwiseArcToRel        = cLargeClockwiseArcSegment        | cRelative
         };
 
+        // How bezier curves are turned into lines
+        enum Flattening
+        {
+            // Split in halves until flat enough
+            cSubdivide = 0,
+            // Segment count from the curvature, points by forward differencing
+            cAnalytic
+        };
+
         struct SubPath
         {
             SubPath():offset_(0),numberOfSegments_(0){}
@@ -100,7 +109,7 @@ namespace vpl
             vplUint offset_;
         };
 
-        Path():deltaLimit_(0.025f),segmentsValid_(true){}
+        Path():flattening_(cSubdivide),deltaLimit_(0.125f),segmentsValid_(true){}
 
         ~Path(){}
 
@@ -256,11 +265,30 @@ namespace vpl
             return transform_;
         }
 
+        // Curve flattening, the tolerance is the largest distance between
+        // a curve and its lines in device units and only used by cAnalytic
+        inline void setFlattening(Flattening flattening,float tolerance = 0.125f)
+        {
+            flattening_ = flattening;
+            deltaLimit_ = tolerance;
+            segmentsValid_ = false;
+        }
+        inline Flattening getFlattening() const
+        {
+            return flattening_;
+        }
+        inline float getFlatteningTolerance() const
+        {
+            return deltaLimit_;
+        }
+
     private:
 
         friend class Renderer;
 		friend class PointGenerator;
+        friend class CommandBuffer;
 
+        Flattening flattening_;
         float deltaLimit_;
         mutable bool segmentsValid_;
         AffineMatrix transform_;
@@ -278,7 +306,6 @@ namespace vpl
                                              startPoint_(points->getItemCount()),
                                              endPoint_(0),pointIterator_(0),
                                              points_(points){}
-		~Segment(){}
 
 		inline const Path::Segment* getSegment() 
 		{ 
@@ -335,8 +362,6 @@ namespace vpl
                   startPoint_(0),endPoint_(0),pointIterator_(0),
                   points_(0),segments_(0){}
 
-		~SubPath(){}
-
         // Retrieve points from subpath (for fills)
         inline vplUint getNumberOfPoints()
         {
@@ -392,6 +417,12 @@ namespace vpl
 			return points_->getContents() + pointIterator_;
         }
 
+        // Bounds of the points, inverted if there are none
+        inline const Rect& getBounds() const
+        {
+            return bounds_;
+        }
+
     private:
 
 		friend class PointGenerator;
@@ -404,6 +435,7 @@ namespace vpl
         vplUint pointIterator_;
         DynamicArray<float>* points_;
         DynamicArray<Segment>* segments_;
+        Rect bounds_;
 	};
 
 	class VPL_API PointGenerator
@@ -415,6 +447,20 @@ namespace vpl
 
         void generatePoints(const Path& path,
 							const AffineMatrix& transform = AffineMatrix());
+
+        // Map the points of the last generatePoints call to a new transform
+        // without flattening again. The path must be unchanged since then.
+        // Fails if the points would be too coarse or needlessly fine, the
+        // caller then generates them again
+        bool reusePoints(const Path& path,
+                         const AffineMatrix& transform = AffineMatrix());
+
+        // Units per device unit in y included in the transforms, such as
+        // sub pixel rows. Keeps the flattening tolerance in device units
+        inline void setVerticalScale(float scale)
+        {
+            verticalScale_ = scale;
+        }
         
 		inline SubPath* beginSubPathIteration()
         {
@@ -447,6 +493,13 @@ namespace vpl
 			return points_.getItemCount()/2;
 		}
 
+        // Bounds of all subpaths in the space the points were generated
+        // in, inverted if there are no points
+        inline const Rect& getBounds() const
+        {
+            return bounds_;
+        }
+
 	private:
 
 		inline void addPoint(const Vector& p)
@@ -472,11 +525,22 @@ namespace vpl
                           float rh,float rv,float rot,float startAngle,float endAngle);
 		void subDivideBezier(const Vector& from,const Vector& control1,
                              const Vector& control2,const Vector& to);
+        void stepBezier(const float* bezier);
 		void finishSubPath();
+        void transformPoints();
+        void computeBounds();
 
 		DynamicArray<float> points_;
 		DynamicArray<Segment> segments_;
 		DynamicArray<SubPath> subPaths_;
+        // Points as flattened under flattenTransform_, copied on first reuse
+        DynamicArray<float> flattenedPoints_;
+        AffineMatrix flattenTransform_;
+        bool flattenedPointsValid_;
+        Rect bounds_;
+        Path::Flattening flattening_;
+        float tolerance_;
+        float verticalScale_;
 		float deltaLimit_;
 		Vector start_;
 		Vector end_;
@@ -484,6 +548,7 @@ namespace vpl
 		AffineMatrix transform_;
 		vplUint previousCommand_;
 		vplUint subPathIterator_;
+        vplUint transformStart_;
 	};
 
     const char* commandToString(Path::Command command);
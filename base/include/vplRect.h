@@ -29,6 +29,52 @@ namespace vpl
         Rect(float l,float r,float t,float b):left_(l),right_(r),
                                               top_(t),bottom_(b){}
 
+        inline bool isEmpty() const
+        {
+            return left_ >= right_ || bottom_ >= top_;
+        }
+
+        inline bool intersects(const Rect& rect) const
+        {
+            return left_ < rect.right_ && rect.left_ < right_ &&
+                   bottom_ < rect.top_ && rect.bottom_ < top_;
+        }
+
+        // Grow to contain rect
+        inline void unite(const Rect& rect)
+        {
+            if(rect.isEmpty())
+                return;
+
+            if(isEmpty())
+            {
+                *this = rect;
+                return;
+            }
+
+            if(rect.left_ < left_)
+                left_ = rect.left_;
+            if(rect.right_ > right_)
+                right_ = rect.right_;
+            if(rect.top_ > top_)
+                top_ = rect.top_;
+            if(rect.bottom_ < bottom_)
+                bottom_ = rect.bottom_;
+        }
+
+        // Shrink to the part inside rect
+        inline void intersect(const Rect& rect)
+        {
+            if(rect.left_ > left_)
+                left_ = rect.left_;
+            if(rect.right_ < right_)
+                right_ = rect.right_;
+            if(rect.top_ < top_)
+                top_ = rect.top_;
+            if(rect.bottom_ > bottom_)
+                bottom_ = rect.bottom_;
+        }
+
         float left_;
         float right_;
         float top_;
@@ -47,6 +47,10 @@ namespace vpl
 
             ~Stroker(){}
 
+            // Change the pen and start over, the outline storage is kept
+            // so one stroker can be reused for many paths
+            void setStyle(JoinType joinType,EndType endType,float size,float miterlimit);
+
             void generateStrokeOutlines(SubPath* subPath,
                                         const AffineMatrix& transform);
 			// Getters
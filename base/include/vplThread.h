@@ -0,0 +1,141 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VPL_THREAD_H_INCLUDED_
+#define VPL_THREAD_H_INCLUDED_
+
+#include "vplConfig.h"
+
+namespace vpl
+{
+    // Platform specific handles
+    struct ThreadData;
+    struct MutexData;
+    struct ConditionData;
+
+    // Minimal thread wrapper, derive and implement run()
+    class VPL_API Thread
+    {
+    public:
+
+        Thread();
+        virtual ~Thread();
+
+        // Start executing run() in a new thread, a joined thread may be
+        // started again
+        bool start();
+
+        // Wait for run() to return
+        void join();
+
+        inline bool isRunning() const
+        {
+            return running_;
+        }
+
+        // Number of processors available to this process
+        static vplUint getNumberOfProcessors();
+
+    protected:
+
+        virtual void run() = 0;
+
+    private:
+
+        friend struct ThreadData;
+
+        // Not copyable
+        Thread(const Thread&);
+        Thread& operator=(const Thread&);
+
+        ThreadData* data_;
+        bool running_;
+    };
+
+    class VPL_API Mutex
+    {
+    public:
+
+        Mutex();
+        ~Mutex();
+
+        void lock();
+        void unlock();
+
+    private:
+
+        friend class Condition;
+
+        // Not copyable
+        Mutex(const Mutex&);
+        Mutex& operator=(const Mutex&);
+
+        MutexData* data_;
+    };
+
+    // Condition variable, threads wait on it with a locked mutex
+    class VPL_API Condition
+    {
+    public:
+
+        Condition();
+        ~Condition();
+
+        // Unlock mutex and sleep until woken, mutex is locked again
+        // before returning. Wakeups can be spurious, check the state
+        // waited for in a loop
+        void wait(Mutex& mutex);
+
+        // Wake one waiting thread
+        void signal();
+
+        // Wake all waiting threads
+        void broadcast();
+
+    private:
+
+        // Not copyable
+        Condition(const Condition&);
+        Condition& operator=(const Condition&);
+
+        ConditionData* data_;
+    };
+
+    // Lock a mutex for the lifetime of the object
+    class VPL_API MutexLocker
+    {
+    public:
+
+        MutexLocker(Mutex& mutex):mutex_(mutex)
+        {
+            mutex_.lock();
+        }
+        ~MutexLocker()
+        {
+            mutex_.unlock();
+        }
+
+    private:
+
+        MutexLocker(const MutexLocker&);
+        MutexLocker& operator=(const MutexLocker&);
+
+        Mutex& mutex_;
+    };
+}
+#endif
@@ -16,6 +16,7 @@
  */
 
 #include "vplAffineMatrix.h"
+#include "vplKernels.h"
 
 #define SX  m_[0]
 #define SHX m_[1]
@@ -24,28 +25,6 @@
 #define SY  m_[4]
 #define TY  m_[5]
 
-#ifdef USE_SSE2_
-
-extern "C" void PRE_CDECL_ batchTransform(const float* transform,
-                                          float* vectors,
-                                          vplUint numVectors) POST_CDECL_;
-#else
-
-inline void batchTransform(const float* transform,
-                           float* vectors,
-                           vplUint numVectors)
-{
-    for (vplUint i = 0;i < numVectors;i+=2)
-    {
-        float tmpX  = vectors[2*i];
-
-        vectors[2*i] = tmpX * transform[0]  + vectors[2*i+1] * transform[1] + transform[2];
-        vectors[2*i+1] = tmpX * transform[3] + vectors[2*i+1] * transform[4]  + transform[5];
-    }
-}
-
-#endif // USE_SSE2__
-
 namespace vpl
 {
     // Constructor
@@ -153,6 +132,14 @@ namespace vpl
     {
         return SX * SY - SHX * SHY;
     }
+    // Largest singular value, written to stay accurate near the identity
+    float AffineMatrix::computeMaxScale() const
+    {
+        float p = std::sqrt((SX + SY)*(SX + SY) + (SHY - SHX)*(SHY - SHX));
+        float q = std::sqrt((SX - SY)*(SX - SY) + (SHY + SHX)*(SHY + SHX));
+
+        return (p + q)/2.0f;
+    }
 
     // Transform vector
     void AffineMatrix::transform(Vector& vector) const
@@ -178,14 +165,18 @@ namespace vpl
         y = tmpX * SHY + tmpY * SY  + TY;
     }
 
+    // Identity is a no-op and matrices without shear skip the cross terms
     void AffineMatrix::transform(float* vectors,vplUint numVectors) const
     {
-        batchTransform(m_,vectors,numVectors);
+        if(SHX != 0.0f || SHY != 0.0f)
+            getKernels().batchTransform_(m_,vectors,numVectors);
+        else if(SX != 1.0f || SY != 1.0f || TX != 0.0f || TY != 0.0f)
+            getKernels().batchScaleTranslate_(m_,vectors,numVectors);
     }
 
     void AffineMatrix::transform(DynamicArray<float>& vectors) const
     {
-        batchTransform(m_,vectors.getContents(),vectors.getItemCount()/2);
+        transform(vectors.getContents(),vectors.getItemCount()/2);
     }
     // Invert the matrix
     void AffineMatrix::invert()
@@ -225,6 +216,19 @@ namespace vpl
     {
         return AffineMatrix(*this) *= m;
     }
+
+    bool AffineMatrix::operator == (const AffineMatrix& m) const
+    {
+        const float* mPtr = m.getMatrix();
+
+        return SX  == mPtr[0] && SHX == mPtr[1] && TX == mPtr[2] &&
+               SHY == mPtr[3] && SY  == mPtr[4] && TY == mPtr[5];
+    }
+
+    bool AffineMatrix::operator != (const AffineMatrix& m) const
+    {
+        return !(*this == m);
+    }
     // Transformation matrices
     // Translation
     TranslationMatrix::TranslationMatrix(float x,float y)
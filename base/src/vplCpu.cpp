@@ -0,0 +1,117 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "vplCpu.h"
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    #include <intrin.h>
+    #define VPL_CPUID_
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    #include <cpuid.h>
+    #define VPL_CPUID_
+#endif
+
+#ifdef VPL_CPUID_
+
+// Query cpuid leaf and subleaf
+static void cpuid(vplUint32 leaf,vplUint32 subLeaf,vplUint32 regs[4])
+{
+#ifdef _MSC_VER
+    int info[4];
+
+    __cpuidex(info,leaf,subLeaf);
+
+    for(int i = 0; i < 4; i++)
+        regs[i] = static_cast<vplUint32>(info[i]);
+#else
+    __cpuid_count(leaf,subLeaf,regs[0],regs[1],regs[2],regs[3]);
+#endif
+}
+
+// Register state enabled by the operating system
+static vplUint64 getEnabledState()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    vplUint32 eax,edx;
+
+    __asm__ __volatile__("xgetbv" : "=a"(eax),"=d"(edx) : "c"(0));
+
+    return (static_cast<vplUint64>(edx) << 32) | eax;
+#endif
+}
+
+static vplUint32 detectCpuFeatures()
+{
+    vplUint32 regs[4];
+    vplUint32 features = 0;
+
+    cpuid(0,0,regs);
+
+    vplUint32 maxLeaf = regs[0];
+
+    if(maxLeaf < 1)
+        return 0;
+
+    cpuid(1,0,regs);
+
+    if(regs[3] & (1 << 26))
+        features |= vpl::cCpuSSE2;
+
+    if(regs[2] & (1 << 19))
+        features |= vpl::cCpuSSE41;
+
+    if(regs[2] & (1 << 23))
+        features |= vpl::cCpuPopcnt;
+
+    // AVX state must be saved by the operating system
+    if(!(regs[2] & (1 << 27)) || maxLeaf < 7)
+        return features;
+
+    vplUint64 state = getEnabledState();
+
+    cpuid(7,0,regs);
+
+    // XMM and YMM
+    if((state & 0x6) == 0x6 && (regs[1] & (1 << 5)))
+        features |= vpl::cCpuAVX2;
+
+    // Opmask, ZMM low and high
+    if((state & 0xe6) == 0xe6 && (regs[1] & (1 << 16)) && (regs[1] & (1 << 30)))
+        features |= vpl::cCpuAVX512;
+
+    return features;
+}
+
+#else // VPL_CPUID_
+
+static vplUint32 detectCpuFeatures()
+{
+    return 0;
+}
+
+#endif // VPL_CPUID_
+
+namespace vpl
+{
+    vplUint32 getCpuFeatures()
+    {
+        return detectCpuFeatures();
+    }
+}
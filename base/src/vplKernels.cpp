@@ -0,0 +1,96 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "vplKernels.h"
+#include "vplCpu.h"
+
+namespace vpl
+{
+    // Reference versions, used where nothing better is available
+    static void memFill32Scalar(vplUint32* dest,vplUint32 value,vplUint count)
+    {
+        for(vplUint i = 0; i < count; i++)
+            dest[i] = value;
+    }
+
+    static void estimateFlatnessScalar(const float* bezier,float* deltas)
+    {
+        deltas[0] = 3.0f*bezier[2] - 2.0f*bezier[0] - bezier[6];
+        deltas[0]*= deltas[0];
+        deltas[1] = 3.0f*bezier[3] - 2.0f*bezier[1] - bezier[7];
+        deltas[1]*= deltas[1];
+        deltas[2] = 3.0f*bezier[4] - 2.0f*bezier[6] - bezier[0];
+        deltas[2]*= deltas[2];
+        deltas[3] = 3.0f*bezier[5] - 2.0f*bezier[7] - bezier[1];
+        deltas[3]*= deltas[3];
+    }
+
+    static void batchTransformScalar(const float* transform,float* vectors,
+                                     vplUint numVectors)
+    {
+        for(vplUint i = 0; i < numVectors; i++)
+        {
+            float tmpX = vectors[2*i];
+
+            vectors[2*i]   = tmpX * transform[0] + vectors[2*i+1] * transform[1] + transform[2];
+            vectors[2*i+1] = tmpX * transform[3] + vectors[2*i+1] * transform[4] + transform[5];
+        }
+    }
+
+    static void batchScaleTranslateScalar(const float* transform,float* vectors,
+                                          vplUint numVectors)
+    {
+        for(vplUint i = 0; i < numVectors; i++)
+        {
+            vectors[2*i]   = vectors[2*i]   * transform[0] + transform[2];
+            vectors[2*i+1] = vectors[2*i+1] * transform[4] + transform[5];
+        }
+    }
+
+    static Kernels chooseKernels()
+    {
+        Kernels kernels;
+
+        kernels.memFill32_ = &memFill32Scalar;
+        kernels.estimateFlatness_ = &estimateFlatnessScalar;
+        kernels.batchTransform_ = &batchTransformScalar;
+        kernels.batchScaleTranslate_ = &batchScaleTranslateScalar;
+
+#ifdef HAVE_X86_KERNELS_
+        vplUint32 features = getCpuFeatures();
+
+        // Each level only replaces the kernels it does better
+        if(features & cCpuSSE2)
+            setKernelsSSE2(kernels);
+        if(features & cCpuAVX2)
+            setKernelsAVX2(kernels);
+        if(features & cCpuAVX512)
+            setKernelsAVX512(kernels);
+#endif
+
+        return kernels;
+    }
+
+    // Chosen once when the library is loaded
+    static const Kernels kernels = chooseKernels();
+
+    const Kernels& getKernels()
+    {
+        return kernels;
+    }
+}
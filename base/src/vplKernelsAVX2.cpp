@@ -0,0 +1,106 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <immintrin.h>
+#include "vplKernels.h"
+
+// Compiled with AVX2 enabled, only called when the processor has it
+namespace
+{
+    void memFill32AVX2(vplUint32* dest,vplUint32 value,vplUint count)
+    {
+        __m256i v = _mm256_set1_epi32(static_cast<int>(value));
+        vplUint end = count - count % 8;
+
+        for(vplUint i = 0; i < end; i += 8)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),v);
+
+        for(vplUint i = end; i < count; i++)
+            dest[i] = value;
+    }
+
+    // Four vectors at a time
+    void batchTransformAVX2(const float* transform,float* vectors,
+                            vplUint numVectors)
+    {
+        __m256 xScale = _mm256_setr_ps(transform[0],transform[3],transform[0],transform[3],
+                                       transform[0],transform[3],transform[0],transform[3]);
+        __m256 yScale = _mm256_setr_ps(transform[1],transform[4],transform[1],transform[4],
+                                       transform[1],transform[4],transform[1],transform[4]);
+        __m256 translate = _mm256_setr_ps(transform[2],transform[5],transform[2],transform[5],
+                                          transform[2],transform[5],transform[2],transform[5]);
+
+        vplUint end = numVectors - numVectors % 4;
+
+        for(vplUint i = 0; i < end; i += 4)
+        {
+            __m256 v = _mm256_loadu_ps(vectors + 2*i);
+            __m256 x = _mm256_moveldup_ps(v);
+            __m256 y = _mm256_movehdup_ps(v);
+
+            v = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x,xScale),
+                                            _mm256_mul_ps(y,yScale)),translate);
+
+            _mm256_storeu_ps(vectors + 2*i,v);
+        }
+
+        for(vplUint i = end; i < numVectors; i++)
+        {
+            float tmpX = vectors[2*i];
+
+            vectors[2*i]   = tmpX * transform[0] + vectors[2*i+1] * transform[1] + transform[2];
+            vectors[2*i+1] = tmpX * transform[3] + vectors[2*i+1] * transform[4] + transform[5];
+        }
+    }
+
+    // Four vectors at a time
+    void batchScaleTranslateAVX2(const float* transform,float* vectors,
+                                 vplUint numVectors)
+    {
+        __m256 scale = _mm256_setr_ps(transform[0],transform[4],transform[0],transform[4],
+                                      transform[0],transform[4],transform[0],transform[4]);
+        __m256 translate = _mm256_setr_ps(transform[2],transform[5],transform[2],transform[5],
+                                          transform[2],transform[5],transform[2],transform[5]);
+
+        vplUint end = numVectors - numVectors % 4;
+
+        for(vplUint i = 0; i < end; i += 4)
+        {
+            __m256 v = _mm256_loadu_ps(vectors + 2*i);
+
+            _mm256_storeu_ps(vectors + 2*i,_mm256_add_ps(_mm256_mul_ps(v,scale),translate));
+        }
+
+        for(vplUint i = end; i < numVectors; i++)
+        {
+            vectors[2*i]   = vectors[2*i]   * transform[0] + transform[2];
+            vectors[2*i+1] = vectors[2*i+1] * transform[4] + transform[5];
+        }
+    }
+}
+
+namespace vpl
+{
+    // The flatness estimate only has four lanes, keep the SSE2 version
+    void setKernelsAVX2(Kernels& kernels)
+    {
+        kernels.memFill32_ = &memFill32AVX2;
+        kernels.batchTransform_ = &batchTransformAVX2;
+        kernels.batchScaleTranslate_ = &batchScaleTranslateAVX2;
+    }
+}
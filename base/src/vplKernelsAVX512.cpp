@@ -0,0 +1,130 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <immintrin.h>
+#include "vplKernels.h"
+
+// Compiled with AVX-512 enabled, only called when the processor has it
+namespace
+{
+    void memFill32AVX512(vplUint32* dest,vplUint32 value,vplUint count)
+    {
+        __m512i v = _mm512_set1_epi32(static_cast<int>(value));
+        vplUint end = count - count % 16;
+
+        for(vplUint i = 0; i < end; i += 16)
+            _mm512_storeu_si512(dest + i,v);
+
+        // Masked store of what is left
+        if(end < count)
+        {
+            __mmask16 mask = static_cast<__mmask16>((1u << (count - end)) - 1);
+
+            _mm512_mask_storeu_epi32(dest + end,mask,v);
+        }
+    }
+
+    // Eight vectors at a time
+    void batchTransformAVX512(const float* transform,float* vectors,
+                              vplUint numVectors)
+    {
+        float xScale[16];
+        float yScale[16];
+        float translate[16];
+
+        for(int i = 0; i < 16; i += 2)
+        {
+            xScale[i] = transform[0];
+            xScale[i + 1] = transform[3];
+            yScale[i] = transform[1];
+            yScale[i + 1] = transform[4];
+            translate[i] = transform[2];
+            translate[i + 1] = transform[5];
+        }
+
+        __m512 xs = _mm512_loadu_ps(xScale);
+        __m512 ys = _mm512_loadu_ps(yScale);
+        __m512 ts = _mm512_loadu_ps(translate);
+
+        vplUint end = numVectors - numVectors % 8;
+
+        for(vplUint i = 0; i < end; i += 8)
+        {
+            __m512 v = _mm512_loadu_ps(vectors + 2*i);
+            __m512 x = _mm512_moveldup_ps(v);
+            __m512 y = _mm512_movehdup_ps(v);
+
+            v = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x,xs),
+                                            _mm512_mul_ps(y,ys)),ts);
+
+            _mm512_storeu_ps(vectors + 2*i,v);
+        }
+
+        for(vplUint i = end; i < numVectors; i++)
+        {
+            float tmpX = vectors[2*i];
+
+            vectors[2*i]   = tmpX * transform[0] + vectors[2*i+1] * transform[1] + transform[2];
+            vectors[2*i+1] = tmpX * transform[3] + vectors[2*i+1] * transform[4] + transform[5];
+        }
+    }
+
+    // Eight vectors at a time
+    void batchScaleTranslateAVX512(const float* transform,float* vectors,
+                                   vplUint numVectors)
+    {
+        float scale[16];
+        float translate[16];
+
+        for(int i = 0; i < 16; i += 2)
+        {
+            scale[i] = transform[0];
+            scale[i + 1] = transform[4];
+            translate[i] = transform[2];
+            translate[i + 1] = transform[5];
+        }
+
+        __m512 ss = _mm512_loadu_ps(scale);
+        __m512 ts = _mm512_loadu_ps(translate);
+
+        vplUint end = numVectors - numVectors % 8;
+
+        for(vplUint i = 0; i < end; i += 8)
+        {
+            __m512 v = _mm512_loadu_ps(vectors + 2*i);
+
+            _mm512_storeu_ps(vectors + 2*i,_mm512_add_ps(_mm512_mul_ps(v,ss),ts));
+        }
+
+        for(vplUint i = end; i < numVectors; i++)
+        {
+            vectors[2*i]   = vectors[2*i]   * transform[0] + transform[2];
+            vectors[2*i+1] = vectors[2*i+1] * transform[4] + transform[5];
+        }
+    }
+}
+
+namespace vpl
+{
+    void setKernelsAVX512(Kernels& kernels)
+    {
+        kernels.memFill32_ = &memFill32AVX512;
+        kernels.batchTransform_ = &batchTransformAVX512;
+        kernels.batchScaleTranslate_ = &batchScaleTranslateAVX512;
+    }
+}
@@ -0,0 +1,119 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <emmintrin.h>
+#include "vplKernels.h"
+
+namespace
+{
+    void memFill32SSE2(vplUint32* dest,vplUint32 value,vplUint count)
+    {
+        __m128i v = _mm_set1_epi32(static_cast<int>(value));
+        vplUint end = count - count % 4;
+
+        for(vplUint i = 0; i < end; i += 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),v);
+
+        for(vplUint i = end; i < count; i++)
+            dest[i] = value;
+    }
+
+    // All four deltas at once, same operation order as the scalar code
+    void estimateFlatnessSSE2(const float* bezier,float* deltas)
+    {
+        __m128 first = _mm_loadu_ps(bezier);
+        __m128 last = _mm_loadu_ps(bezier + 4);
+
+        // p2, p3
+        __m128 controls = _mm_loadu_ps(bezier + 2);
+        // p1, p4
+        __m128 ends = _mm_shuffle_ps(first,last,_MM_SHUFFLE(3,2,1,0));
+        // p4, p1
+        __m128 opposite = _mm_shuffle_ps(last,first,_MM_SHUFFLE(1,0,3,2));
+
+        __m128 d = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(3.0f),controls),
+                              _mm_mul_ps(_mm_set1_ps(2.0f),ends));
+        d = _mm_sub_ps(d,opposite);
+
+        _mm_storeu_ps(deltas,_mm_mul_ps(d,d));
+    }
+
+    // Two vectors at a time
+    void batchTransformSSE2(const float* transform,float* vectors,
+                            vplUint numVectors)
+    {
+        __m128 xScale = _mm_setr_ps(transform[0],transform[3],transform[0],transform[3]);
+        __m128 yScale = _mm_setr_ps(transform[1],transform[4],transform[1],transform[4]);
+        __m128 translate = _mm_setr_ps(transform[2],transform[5],transform[2],transform[5]);
+
+        vplUint end = numVectors - numVectors % 2;
+
+        for(vplUint i = 0; i < end; i += 2)
+        {
+            __m128 v = _mm_loadu_ps(vectors + 2*i);
+            __m128 x = _mm_shuffle_ps(v,v,_MM_SHUFFLE(2,2,0,0));
+            __m128 y = _mm_shuffle_ps(v,v,_MM_SHUFFLE(3,3,1,1));
+
+            v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x,xScale),_mm_mul_ps(y,yScale)),translate);
+
+            _mm_storeu_ps(vectors + 2*i,v);
+        }
+
+        if(end < numVectors)
+        {
+            float tmpX = vectors[2*end];
+
+            vectors[2*end]   = tmpX * transform[0] + vectors[2*end+1] * transform[1] + transform[2];
+            vectors[2*end+1] = tmpX * transform[3] + vectors[2*end+1] * transform[4] + transform[5];
+        }
+    }
+
+    // Two vectors at a time
+    void batchScaleTranslateSSE2(const float* transform,float* vectors,
+                                 vplUint numVectors)
+    {
+        __m128 scale = _mm_setr_ps(transform[0],transform[4],transform[0],transform[4]);
+        __m128 translate = _mm_setr_ps(transform[2],transform[5],transform[2],transform[5]);
+
+        vplUint end = numVectors - numVectors % 2;
+
+        for(vplUint i = 0; i < end; i += 2)
+        {
+            __m128 v = _mm_loadu_ps(vectors + 2*i);
+
+            _mm_storeu_ps(vectors + 2*i,_mm_add_ps(_mm_mul_ps(v,scale),translate));
+        }
+
+        if(end < numVectors)
+        {
+            vectors[2*end]   = vectors[2*end]   * transform[0] + transform[2];
+            vectors[2*end+1] = vectors[2*end+1] * transform[4] + transform[5];
+        }
+    }
+}
+
+namespace vpl
+{
+    void setKernelsSSE2(Kernels& kernels)
+    {
+        kernels.memFill32_ = &memFill32SSE2;
+        kernels.estimateFlatness_ = &estimateFlatnessSSE2;
+        kernels.batchTransform_ = &batchTransformSSE2;
+        kernels.batchScaleTranslate_ = &batchScaleTranslateSSE2;
+    }
+}
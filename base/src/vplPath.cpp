@@ -15,35 +15,11 @@
  * if not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cfloat>
 #include "vplAffineMatrix.h"
+#include "vplKernels.h"
 #include "vplPath.h"
 
-#ifdef USE_SSE2_
-
-extern "C" void PRE_CDECL_ estimateFlatness(float* bezier,float* deltas) POST_CDECL_;
-
-#define DECLARE_ARRAY(a) MEM_ALIGN(a,16)
-#define ALIGN_ARRAY(b) b.align(cAlign16)
-
-#else
-
-inline static void estimateFlatness(float* bezier,float* deltas)
-{
-    deltas[0] = 3.0f*bezier[2] - 2.0f*bezier[0] - bezier[6];
-    deltas[0]*= deltas[0];
-    deltas[1] = 3.0f*bezier[3] - 2.0f*bezier[1] - bezier[7];
-    deltas[1]*= deltas[1];
-    deltas[2] = 3.0f*bezier[4] - 2.0f*bezier[6] - bezier[0];
-    deltas[2]*= deltas[2];
-    deltas[3] = 3.0f*bezier[5] - 2.0f*bezier[7] - bezier[1];
-    deltas[3]*= deltas[3];
-}
-
-#define DECLARE_ARRAY(a) a
-#define ALIGN_ARRAY(b)
-
-#endif // USE_SSE__
-
 namespace vpl
 {
 	const char* commandToString(Path::Command command)
@@ -195,10 +171,11 @@ namespace vpl
         segments_.clear();
     }
 
-	PointGenerator::PointGenerator():deltaLimit_(0.25f),previousCommand_(0),
-			                         subPathIterator_(0)
+	PointGenerator::PointGenerator():flattenedPointsValid_(false),
+                                     flattening_(Path::cSubdivide),tolerance_(0.125f),
+                                     verticalScale_(1.0f),deltaLimit_(0.25f),previousCommand_(0),
+                                     subPathIterator_(0),transformStart_(0)
 	{
-		ALIGN_ARRAY(points_);
 	}
 
 	void PointGenerator::generatePoints(const Path& path,const AffineMatrix& transform)
@@ -207,10 +184,17 @@ namespace vpl
 		transform_ = path.getTransform();
 		transform_ *= transform;
 
+        flattenTransform_ = transform_;
+
+        flattening_ = path.flattening_;
+        tolerance_ = path.deltaLimit_;
+
         // Clear old data
 		points_.clear();
         subPaths_.clear();
 		segments_.clear();
+        flattenedPointsValid_ = false;
+        transformStart_ = 0;
 
         // Reset state variables
         start_ = end_ = lastControl_ = Vector(0.0f,0.0f);
@@ -402,13 +386,9 @@ namespace vpl
 
         // Flush last point
 		if(command != Path::cClosePath)
-		{
-            Vector end = end_;
+			addPoint(end_);
 
-			transform_.transform(end);
-
-			addPoint(end);
-		}
+        transformPoints();
 
 		// Fix subpaths
 		if(subPaths_.getItemCount() > 0)
@@ -417,18 +397,58 @@ namespace vpl
             subPaths_.getLast().endPoint_ = points_.getItemCount();
             segments_.getLast().endPoint_ = points_.getItemCount();
         }
+
+        computeBounds();
     }
 
-	void PointGenerator::moveTo(float x,float y)
+    // Flattening error scales with the transform, so the points stay
+    // within tolerance as long as the change does not stretch them
+    static const float cMaxReuseScale = 1.001f;
+    static const float cMinReuseScale = 0.5f;
+
+    bool PointGenerator::reusePoints(const Path& path,const AffineMatrix& transform)
     {
-		if(points_.getItemCount() && previousCommand_ != Path::cClosePath)
-		{
-			Vector end = end_;
+        AffineMatrix newTransform = path.getTransform();
+        newTransform *= transform;
 
-			transform_.transform(end);
+        if(newTransform == transform_)
+            return true;
 
-			addPoint(end);
-		}
+        // Maps the flattened points to the new transform
+        AffineMatrix change = flattenTransform_;
+        change.invert();
+        change *= newTransform;
+
+        float scale = change.computeMaxScale();
+
+        if(!(scale >= cMinReuseScale && scale <= cMaxReuseScale))
+            return false;
+
+        if(!flattenedPointsValid_)
+        {
+            flattenedPoints_.clear();
+            flattenedPoints_.add(points_.getContents(),points_.getItemCount());
+
+            flattenedPointsValid_ = true;
+        }
+
+        DynamicMemory<float>::copy(points_.getContents(),
+                                   flattenedPoints_.getContents(),
+                                   points_.getItemCount());
+
+        change.transform(points_);
+
+        transform_ = newTransform;
+
+        computeBounds();
+
+        return true;
+    }
+
+	void PointGenerator::moveTo(float x,float y)
+    {
+		if(points_.getItemCount() && previousCommand_ != Path::cClosePath)
+			addPoint(end_);
 
         if(subPaths_.getItemCount())
         {
@@ -453,11 +473,7 @@ namespace vpl
     void PointGenerator::lineTo(float x,float y)
     {
         // Generate point
-        Vector end = end_;
-
-		transform_.transform(end);
-
-		addPoint(end);
+		addPoint(end_);
 
         // Update internal reference points
         end_ = lastControl_ = Vector(x,y);
@@ -601,21 +617,30 @@ namespace vpl
     void PointGenerator::finishSubPath()
     {
         // Generate points
-		Vector end = end_;
-		Vector start = start_;
-
-		transform_.transform(end);
-		transform_.transform(start);
-
-		addPoint(end);
+		addPoint(end_);
 
         if(end_ != start_)
-            addPoint(start);
+            addPoint(start_);
 
         // Update internal reference points
         end_ = lastControl_ = start_;
     }
 
+    // Points are added in user space and transformed in batches. Only
+    // beziers add device space points, they flush the batch first
+    void PointGenerator::transformPoints()
+    {
+        vplUint count = points_.getItemCount();
+
+        if(count > transformStart_)
+        {
+            transform_.transform(points_.getContents() + transformStart_,
+                                 (count - transformStart_)/2);
+        }
+
+        transformStart_ = count;
+    }
+
     // The max recurse depth
     static const char cMaxRecurseStackSize = 32;
 
@@ -645,8 +670,8 @@ namespace vpl
 		transform_.transform(newControl2);
 
         // IF we use SSE, data is aligned via this macro
-        DECLARE_ARRAY(float bezier[8*cMaxRecurseStackSize]);
-        DECLARE_ARRAY(float deltas[4]);
+        float bezier[8*cMaxRecurseStackSize];
+        float deltas[4];
 
         // Pointer into stack
         float* currentBez;
@@ -673,15 +698,26 @@ namespace vpl
 
         int bezIndex = 0;
 
+        FlatnessKernel estimateFlatness = getKernels().estimateFlatness_;
+
         // Add very first point
+        transformPoints();
         addPoint(newFrom);
 
+        // The rest in one go, skips the subdivision
+        if(flattening_ == Path::cAnalytic)
+        {
+            stepBezier(bezier);
+
+            bezIndex = -1;
+        }
+
         while(bezIndex >= 0)
         {
             // Set current bezier
             currentBez = bezier + bezIndex*8;
 
-            // Call SSE subdivison
+            // Estimate how far the curve is from a line
             estimateFlatness(bezier + bezIndex*8,deltas);
 
             // Choose max
@@ -732,6 +768,124 @@ namespace vpl
                 *(rightBez+7) = *(currentBez+7);
             }
         }
+
+        // Already in device space
+        transformStart_ = points_.getItemCount();
+    }
+
+    // Lets the edge generation skip clipping subpaths that are inside the
+    // clip rect and skip subpaths that are outside it
+    void PointGenerator::computeBounds()
+    {
+        float minX = FLT_MAX;
+        float maxX = -FLT_MAX;
+        float minY = FLT_MAX;
+        float maxY = -FLT_MAX;
+
+        const float* points = points_.getContents();
+
+        for(vplUint i = 0; i < subPaths_.getItemCount(); i++)
+        {
+            SubPath& subPath = subPaths_[i];
+
+            float subMinX = FLT_MAX;
+            float subMaxX = -FLT_MAX;
+            float subMinY = FLT_MAX;
+            float subMaxY = -FLT_MAX;
+
+            for(vplUint j = subPath.startPoint_; j + 1 < subPath.endPoint_; j += 2)
+            {
+                if(points[j] < subMinX)
+                    subMinX = points[j];
+                if(points[j] > subMaxX)
+                    subMaxX = points[j];
+                if(points[j + 1] < subMinY)
+                    subMinY = points[j + 1];
+                if(points[j + 1] > subMaxY)
+                    subMaxY = points[j + 1];
+            }
+
+            subPath.bounds_ = Rect(subMinX,subMaxX,subMaxY,subMinY);
+
+            if(subMinX < minX)
+                minX = subMinX;
+            if(subMaxX > maxX)
+                maxX = subMaxX;
+            if(subMinY < minY)
+                minY = subMinY;
+            if(subMaxY > maxY)
+                maxY = subMaxY;
+        }
+
+        bounds_ = Rect(minX,maxX,maxY,minY);
+    }
+
+    // A curve needing more steps is far off screen or broken
+    static const float cMaxBezierSteps = 1024.0f;
+
+    // Wang's formula gives the number of equal parameter steps that keep
+    // the lines within tolerance_ of the curve. The points in between are
+    // found by forward differencing, relative to the start for precision
+    void PointGenerator::stepBezier(const float* bezier)
+    {
+        // Measure the error in device units
+        float yScale = 1.0f/verticalScale_;
+
+        float ddx0 = bezier[0] - 2.0f*bezier[2] + bezier[4];
+        float ddy0 = (bezier[1] - 2.0f*bezier[3] + bezier[5])*yScale;
+        float ddx1 = bezier[2] - 2.0f*bezier[4] + bezier[6];
+        float ddy1 = (bezier[3] - 2.0f*bezier[5] + bezier[7])*yScale;
+
+        float dd = ddx0*ddx0 + ddy0*ddy0;
+
+        if(dd < ddx1*ddx1 + ddy1*ddy1)
+            dd = ddx1*ddx1 + ddy1*ddy1;
+
+        float steps = std::ceil(std::sqrt(0.75f*std::sqrt(dd)/tolerance_));
+
+        // Also catches NaN
+        if(!(steps <= cMaxBezierSteps))
+            steps = cMaxBezierSteps;
+
+        int count = static_cast<int>(steps);
+
+        // A single line, the end point is added by the next segment
+        if(count < 2)
+            return;
+
+        // Coefficients of the polynomial
+        float ax = 3.0f*(bezier[2] - bezier[4]) + bezier[6] - bezier[0];
+        float ay = 3.0f*(bezier[3] - bezier[5]) + bezier[7] - bezier[1];
+        float bx = 3.0f*(bezier[0] - 2.0f*bezier[2] + bezier[4]);
+        float by = 3.0f*(bezier[1] - 2.0f*bezier[3] + bezier[5]);
+        float cx = 3.0f*(bezier[2] - bezier[0]);
+        float cy = 3.0f*(bezier[3] - bezier[1]);
+
+        float h  = 1.0f/steps;
+        float h2 = h*h;
+        float h3 = h2*h;
+
+        // Forward differences
+        float x = 0.0f;
+        float y = 0.0f;
+        float dx = ax*h3 + bx*h2 + cx*h;
+        float dy = ay*h3 + by*h2 + cy*h;
+        float ddx = 6.0f*ax*h3 + 2.0f*bx*h2;
+        float ddy = 6.0f*ay*h3 + 2.0f*by*h2;
+        float dddx = 6.0f*ax*h3;
+        float dddy = 6.0f*ay*h3;
+
+        for(int i = 1; i < count; i++)
+        {
+            x += dx;
+            y += dy;
+            dx += ddx;
+            dy += ddy;
+            ddx += dddx;
+            ddy += dddy;
+
+            addPoint(bezier[0] + x,bezier[1] + y);
+        }
     }
 
     // Arc segment
@@ -774,10 +928,7 @@ namespace vpl
         arcStack[0].endAngle   = endAngle;
 
         // Add first point
-        Vector transformedPoint;
-        transform_.transform(from,transformedPoint);
-
-        addPoint(transformedPoint);
+        addPoint(from);
 
         while(arcIndex >= 0)
         {
@@ -814,15 +965,11 @@ namespace vpl
               // Add middle and end points
               arcIndex--;
 
-              transform_.transform(newPoint,transformedPoint);
-
-              addPoint(transformedPoint);
+              addPoint(newPoint);
 
               if(arcIndex >= 0)
               {
-                  transform_.transform(currentArc->end,transformedPoint);
-
-                  addPoint(transformedPoint);
+                  addPoint(currentArc->end);
               }
             }
             else
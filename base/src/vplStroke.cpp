@@ -28,12 +28,24 @@ namespace vpl
     }
 
     Stroker::Stroker(JoinType joinType,EndType endType,
-                     float size,float miterlimit):joinType_(joinType),
-                                                  endType_(endType),
-                                                  size_(size),
-                                                  miterLimit_(miterlimit),
-                                                  numSegments_(0)
+                     float size,float miterlimit)
     {
+        setStyle(joinType,endType,size,miterlimit);
+    }
+
+    void Stroker::setStyle(JoinType joinType,EndType endType,
+                           float size,float miterlimit)
+    {
+        joinType_   = joinType;
+        endType_    = endType;
+        size_       = size;
+        miterLimit_ = miterlimit;
+
+        // Start over as a new stroker would
+        numSegments_ = 0;
+        currentPoint_ = prevPoint_ = firstPoint_ = Vector();
+        normal_ = prevNormal_ = firstNormal_ = Vector();
+
         // Choose correct joiner
         switch(joinType_)
         {
@@ -54,6 +66,12 @@ namespace vpl
     void Stroker::generateStrokeOutlines(SubPath* subPath,
                                          const AffineMatrix& transform)
     {
+        // Clear state varibles and helper paths for this subpath
+        numSegments_ = 0;
+
+        innerPoints_.clear();
+        outerPoints_.clear();
+
         if(subPath->getNumberOfPoints() == 0)
             return;
 
@@ -62,12 +80,6 @@ namespace vpl
 
         const Path::Segment* pathSegment = segment->getSegment();
 
-        // Clear state varibles and helper paths for this subpath
-        numSegments_ = 0;
-
-        innerPoints_.clear();
-        outerPoints_.clear();
-
         // Store transform
         pathTransform_ = transform;
         inversePathTransform_ = transform;
@@ -0,0 +1,259 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "vplThread.h"
+#include "vplLog.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+namespace vpl
+{
+#ifdef _WIN32
+
+    struct ThreadData
+    {
+        ThreadData():handle_(0){}
+
+        static DWORD WINAPI entry(LPVOID thread)
+        {
+            static_cast<Thread*>(thread)->run();
+
+            return 0;
+        }
+
+        HANDLE handle_;
+    };
+
+    struct MutexData
+    {
+        CRITICAL_SECTION section_;
+    };
+
+    struct ConditionData
+    {
+        CONDITION_VARIABLE condition_;
+    };
+
+    bool Thread::start()
+    {
+        if(running_)
+            return false;
+
+        data_->handle_ = CreateThread(0,0,&ThreadData::entry,this,0,0);
+
+        if(!data_->handle_)
+        {
+            STD_LOG_ERROR() << "Could not create thread";
+            return false;
+        }
+
+        running_ = true;
+
+        return true;
+    }
+
+    void Thread::join()
+    {
+        if(!running_)
+            return;
+
+        WaitForSingleObject(data_->handle_,INFINITE);
+        CloseHandle(data_->handle_);
+
+        data_->handle_ = 0;
+        running_ = false;
+    }
+
+    vplUint Thread::getNumberOfProcessors()
+    {
+        SYSTEM_INFO info;
+
+        GetSystemInfo(&info);
+
+        return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+    }
+
+    Mutex::Mutex():data_(new MutexData())
+    {
+        InitializeCriticalSection(&data_->section_);
+    }
+
+    Mutex::~Mutex()
+    {
+        DeleteCriticalSection(&data_->section_);
+        delete data_;
+    }
+
+    void Mutex::lock()
+    {
+        EnterCriticalSection(&data_->section_);
+    }
+
+    void Mutex::unlock()
+    {
+        LeaveCriticalSection(&data_->section_);
+    }
+
+    Condition::Condition():data_(new ConditionData())
+    {
+        InitializeConditionVariable(&data_->condition_);
+    }
+
+    Condition::~Condition()
+    {
+        delete data_;
+    }
+
+    void Condition::wait(Mutex& mutex)
+    {
+        SleepConditionVariableCS(&data_->condition_,&mutex.data_->section_,INFINITE);
+    }
+
+    void Condition::signal()
+    {
+        WakeConditionVariable(&data_->condition_);
+    }
+
+    void Condition::broadcast()
+    {
+        WakeAllConditionVariable(&data_->condition_);
+    }
+
+#else // _WIN32
+
+    struct ThreadData
+    {
+        static void* entry(void* thread)
+        {
+            static_cast<Thread*>(thread)->run();
+
+            return 0;
+        }
+
+        pthread_t handle_;
+    };
+
+    struct MutexData
+    {
+        pthread_mutex_t mutex_;
+    };
+
+    struct ConditionData
+    {
+        pthread_cond_t condition_;
+    };
+
+    bool Thread::start()
+    {
+        if(running_)
+            return false;
+
+        if(pthread_create(&data_->handle_,0,&ThreadData::entry,this) != 0)
+        {
+            STD_LOG_ERROR() << "Could not create thread";
+            return false;
+        }
+
+        running_ = true;
+
+        return true;
+    }
+
+    void Thread::join()
+    {
+        if(!running_)
+            return;
+
+        pthread_join(data_->handle_,0);
+
+        running_ = false;
+    }
+
+    vplUint Thread::getNumberOfProcessors()
+    {
+        long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+        return count > 0 ? static_cast<vplUint>(count) : 1;
+    }
+
+    Mutex::Mutex():data_(new MutexData())
+    {
+        pthread_mutex_init(&data_->mutex_,0);
+    }
+
+    Mutex::~Mutex()
+    {
+        pthread_mutex_destroy(&data_->mutex_);
+        delete data_;
+    }
+
+    void Mutex::lock()
+    {
+        pthread_mutex_lock(&data_->mutex_);
+    }
+
+    void Mutex::unlock()
+    {
+        pthread_mutex_unlock(&data_->mutex_);
+    }
+
+    Condition::Condition():data_(new ConditionData())
+    {
+        pthread_cond_init(&data_->condition_,0);
+    }
+
+    Condition::~Condition()
+    {
+        pthread_cond_destroy(&data_->condition_);
+        delete data_;
+    }
+
+    void Condition::wait(Mutex& mutex)
+    {
+        pthread_cond_wait(&data_->condition_,&mutex.data_->mutex_);
+    }
+
+    void Condition::signal()
+    {
+        pthread_cond_signal(&data_->condition_);
+    }
+
+    void Condition::broadcast()
+    {
+        pthread_cond_broadcast(&data_->condition_);
+    }
+
+#endif // _WIN32
+
+    Thread::Thread():data_(new ThreadData()),running_(false)
+    {
+    }
+
+    Thread::~Thread()
+    {
+        // A thread must not outlive its object
+        join();
+
+        delete data_;
+    }
+}
@@ -0,0 +1,340 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Renders SVG files without a window and prints timings as comma
+// separated values, one line per file, size, sampling and stage.
+//
+// Stages:
+//   first     - paths added and drawn, flattening, edges and fill
+//   transform - renderer transform changed, edges and fill
+//   fill      - whole target invalidated, fill only
+//
+// Usage: render_benchmark [-warmup n] [-repeat n] [-threads n] [svg dir]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#include "SVGParser.h"
+
+// Wall clock in milliseconds
+static double getTime()
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    return 1000.0*static_cast<double>(counter.QuadPart)/
+           static_cast<double>(frequency.QuadPart);
+#else
+    struct timeval time;
+
+    gettimeofday(&time,0);
+
+    return 1000.0*time.tv_sec + 0.001*time.tv_usec;
+#endif
+}
+
+struct Options
+{
+    vplUint warmup_;
+    vplUint repeat_;
+    vplUint threads_;
+    std::string directory_;
+};
+
+struct Scene
+{
+    SVGParser parser_;
+    std::vector<vpl::Path*> paths_;
+};
+
+// Timings of one stage
+struct StageResult
+{
+    StageResult():frames_(0),total_(0.0),min_(0.0),
+                  edges_(0),filledEdges_(0){}
+
+    vplUint frames_;
+    double total_;
+    double min_;
+    // Per frame
+    vplUint edges_;
+    vplUint filledEdges_;
+};
+
+static const char* files[] = {"tiger.svg",
+                              "lion.svg",
+                              "froggy.svg",
+                              "fire_engine.svg",
+                              "lorem_ipsum_compound.svg",
+                              "lorem_ipsum_separate.svg"};
+
+static const float scales[] = {0.5f,1.0f,2.0f};
+
+static const vpl::Renderer::Sampling samplings[] = {vpl::Renderer::cSample8,
+                                                    vpl::Renderer::cSample16,
+                                                    vpl::Renderer::cSample32};
+
+static bool loadScene(Scene& scene,const std::string& fileName)
+{
+    if(!scene.parser_.loadDocument(fileName.c_str()) ||
+       !scene.parser_.parseDocument())
+        return false;
+
+    SVGPath** svgPaths = scene.parser_.getPaths();
+
+    for(vplUint i = 0; i < scene.parser_.getNumberOfPaths(); i++)
+    {
+        SVGPath* svgPath = svgPaths[i];
+
+        if(!svgPath->segments_.getItemCount())
+            continue;
+
+        vpl::Path* path = new vpl::Path();
+
+        path->setTransform(svgPath->transform_);
+
+        for(vplUint j = 0; j < svgPath->segments_.getItemCount(); j++)
+        {
+            path->addSegment(svgPath->segments_[j].command_,
+                             svgPath->segments_[j].args_[0],
+                             svgPath->segments_[j].args_[1],
+                             svgPath->segments_[j].args_[2],
+                             svgPath->segments_[j].args_[3],
+                             svgPath->segments_[j].args_[4],
+                             svgPath->segments_[j].args_[5]);
+        }
+
+        scene.paths_.push_back(path);
+    }
+
+    return true;
+}
+
+static void freeScene(Scene& scene)
+{
+    for(size_t i = 0; i < scene.paths_.size(); i++)
+        delete scene.paths_[i];
+
+    scene.paths_.clear();
+}
+
+static void addPaths(Scene& scene,vpl::Renderer& renderer)
+{
+    SVGPath** svgPaths = scene.parser_.getPaths();
+    vplUint pathIndex = 0;
+
+    for(vplUint i = 0; i < scene.parser_.getNumberOfPaths(); i++)
+    {
+        SVGPath* svgPath = svgPaths[i];
+
+        if(!svgPath->segments_.getItemCount())
+            continue;
+
+        vpl::Path* path = scene.paths_[pathIndex++];
+
+        if(svgPath->fill_ && svgPath->stroke_)
+            renderer.addPath(path,&svgPath->pen_,&svgPath->brush_);
+        else if(svgPath->fill_)
+            renderer.addPath(path,&svgPath->brush_);
+        else
+            renderer.addPath(path,&svgPath->pen_);
+    }
+}
+
+static void addFrame(StageResult& result,double time,
+                     const vpl::Renderer::Statistics& statistics)
+{
+    if(result.frames_ == 0 || time < result.min_)
+        result.min_ = time;
+
+    result.total_ += time;
+    result.frames_++;
+    result.edges_ = statistics.numEdges_;
+    result.filledEdges_ = statistics.numFilledEdges_;
+}
+
+// Draw one frame of a stage and return the time it took
+static double drawFrame(Scene& scene,vpl::Renderer& renderer,
+                        vpl::PixelBuffer& target,const char* stage,
+                        vplUint frame)
+{
+    double start = 0.0;
+
+    if(!strcmp(stage,"first"))
+    {
+        renderer.clearPaths();
+        target.clear(vpl::cWhite);
+
+        start = getTime();
+
+        addPaths(scene,renderer);
+    }
+    else if(!strcmp(stage,"transform"))
+    {
+        // Move back and forth so the scene stays in view
+        float offset = (frame & 1) ? -1.0f : 1.0f;
+
+        start = getTime();
+
+        renderer.transform(vpl::TranslationMatrix(offset,0.0f));
+    }
+    else
+    {
+        start = getTime();
+
+        renderer.invalidate(vpl::Rect(0.0f,static_cast<float>(target.getWidth()),
+                                      static_cast<float>(target.getHeight()),0.0f));
+    }
+
+    renderer.draw();
+
+    return getTime() - start;
+}
+
+static void printResult(const char* file,const vpl::PixelBuffer& target,
+                        vpl::Renderer::Sampling sampling,
+                        const Options& options,const char* stage,
+                        const StageResult& result)
+{
+    double mean = result.total_/result.frames_;
+    double pixels = static_cast<double>(target.getWidth())*target.getHeight();
+    // Generated edges, or the rasterized ones when nothing was generated
+    vplUint edges = result.edges_ ? result.edges_ : result.filledEdges_;
+
+    printf("%s,%u,%u,%d,%u,%s,%u,%.3f,%.3f,%u,%u,%.0f,%.0f\n",
+           file,target.getWidth(),target.getHeight(),
+           static_cast<int>(sampling),options.threads_,stage,result.frames_,
+           result.min_,mean,result.edges_,result.filledEdges_,
+           mean > 0.0 ? 1000.0*edges/mean : 0.0,
+           mean > 0.0 ? 1000.0*pixels/mean : 0.0);
+}
+
+static void runScene(const char* file,Scene& scene,float scale,
+                     vpl::Renderer::Sampling sampling,const Options& options)
+{
+    const char* stages[] = {"first","transform","fill"};
+
+    SVGParser& parser = scene.parser_;
+
+    vplUint width = static_cast<vplUint>(parser.getWidth()*scale + 0.5f);
+    vplUint height = static_cast<vplUint>(parser.getHeight()*scale + 0.5f);
+
+    if(width == 0 || height == 0)
+        return;
+
+    vpl::PixelBuffer target;
+    vpl::Renderer renderer;
+
+    target.initialize(width,height);
+    target.clear(vpl::cWhite);
+
+    renderer.setSamplingValue(sampling);
+    renderer.setNumberOfThreads(options.threads_);
+    renderer.setTarget(&target);
+    renderer.setTransform(vpl::ScalingMatrix(scale));
+
+    for(vplUint i = 0; i < sizeof(stages)/sizeof(stages[0]); i++)
+    {
+        StageResult result;
+
+        for(vplUint j = 0; j < options.warmup_ + options.repeat_; j++)
+        {
+            double time = drawFrame(scene,renderer,target,stages[i],j);
+
+            if(j >= options.warmup_)
+                addFrame(result,time,renderer.getStatistics());
+        }
+
+        printResult(file,target,sampling,options,stages[i],result);
+    }
+
+    renderer.clearPaths();
+}
+
+static bool parseOptions(int argc,char** argv,Options& options)
+{
+    options.warmup_ = 2;
+    options.repeat_ = 10;
+    options.threads_ = 1;
+    options.directory_ = "svg";
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(i + 1 < argc && !strcmp(argv[i],"-warmup"))
+            options.warmup_ = atoi(argv[++i]);
+        else if(i + 1 < argc && !strcmp(argv[i],"-repeat"))
+            options.repeat_ = atoi(argv[++i]);
+        else if(i + 1 < argc && !strcmp(argv[i],"-threads"))
+            options.threads_ = atoi(argv[++i]);
+        else if(argv[i][0] != '-')
+            options.directory_ = argv[i];
+        else
+            return false;
+    }
+
+    return options.repeat_ > 0;
+}
+
+int main(int argc,char** argv)
+{
+    Options options;
+
+    if(!parseOptions(argc,argv,options))
+    {
+        fprintf(stderr,"Usage: %s [-warmup n] [-repeat n] [-threads n] [svg dir]\n",
+                argv[0]);
+        return 1;
+    }
+
+    printf("file,width,height,sampling,threads,stage,frames,ms_min,ms_mean,"
+           "edges,filled_edges,edges_per_s,pixels_per_s\n");
+
+    for(vplUint i = 0; i < sizeof(files)/sizeof(files[0]); i++)
+    {
+        Scene scene;
+
+        if(!loadScene(scene,options.directory_ + "/" + files[i]))
+        {
+            fprintf(stderr,"Could not load %s\n",files[i]);
+            freeScene(scene);
+            continue;
+        }
+
+        for(vplUint j = 0; j < sizeof(scales)/sizeof(scales[0]); j++)
+        {
+            for(vplUint k = 0; k < sizeof(samplings)/sizeof(samplings[0]); k++)
+                runScene(files[i],scene,scales[j],samplings[k],options);
+        }
+
+        freeScene(scene);
+    }
+
+    return 0;
+}
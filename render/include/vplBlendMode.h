@@ -0,0 +1,41 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VPL_BLEND_MODE_H_
+#define VPL_BLEND_MODE_H_
+
+namespace vpl
+{
+    // The different blending modes
+    enum BlendMode
+    {
+        cClear = 0,
+        cSrc,
+        cDest,
+        cSrcOverDest,
+        cDestOverSrc,
+        cSrcInDest,
+        cDestInSrc,
+        cSrcOutDest,
+        cDestOutSrc,
+        cSrcAtopDest,
+        cDestAtopSrc,
+        cSrcXorDest,
+    };
+}
+#endif
@@ -0,0 +1,114 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VPL_COMMAND_BUFFER_H_INCLUDED_
+#define VPL_COMMAND_BUFFER_H_INCLUDED_
+
+#include "vplRender.h"
+
+namespace vpl
+{
+    // Renderer calls recorded as 32 bit words in the byte order of the
+    // machine, so a scene can be stored, sent to another thread and
+    // replayed on any renderer. Paths and gradients are built from the
+    // words once and shared by every replay, several renderers can
+    // replay one buffer on different threads at the same time.
+    class VPL_API CommandBuffer
+    {
+    public:
+
+        CommandBuffer();
+        ~CommandBuffer();
+
+        // Recording, like the renderer calls. Paths, pens and brushes are
+        // copied. A gradient is copied the first time it is used and
+        // again when it changed since.
+        void setClipRect(const Rect& rect);
+        void setTransform(const AffineMatrix& transform);
+        void transform(const AffineMatrix& transform);
+        void addPath(const Path* path,const Pen* pen);
+        void addPath(const Path* path,const Brush* brush);
+        void addPath(const Path* path,const Pen* pen,const Brush* brush);
+        void clearPaths();
+        void draw();
+
+        // Remove all commands and the paths built from them
+        void clear();
+
+        // Serialized commands, the size is in words
+        inline const vplUint32* getData() const
+        {
+            return words_.getContents();
+        }
+
+        inline vplUint getSize() const
+        {
+            return words_.getItemCount();
+        }
+
+        // Replace the commands with serialized ones. Returns false and
+        // leaves the buffer empty if they are broken
+        bool setData(const vplUint32* data,vplUint size);
+
+        // Build the paths and gradients of new commands. Replay does it
+        // too, call this first when replaying on several threads
+        void prepare();
+
+        // Issue the commands on renderer. The paths it gets belong to the
+        // buffer, remove them from the renderer before the buffer is
+        // cleared or deleted
+        void replay(Renderer& renderer);
+
+    private:
+
+        enum Command
+        {
+            cSetClipRectCommand = 1,
+            cSetTransformCommand,
+            cTransformCommand,
+            cAddGradientCommand,
+            cAddPathCommand,
+            cClearPathsCommand,
+            cDrawCommand
+        };
+
+        void addCommand(Command command,vplUint size);
+        void addFloat(float value);
+        void addMatrix(const AffineMatrix& matrix);
+        vplUint addGradient(const Gradient* gradient);
+
+        // Build objects from the words after the ones done already
+        bool decode();
+
+        DynamicArray<vplUint32> words_;
+        // Built from the words for replay
+        DynamicArray<Path*> paths_;
+        DynamicArray<Gradient*> gradients_;
+        // Gradients recorded in this buffer by index, zero for the
+        // ones that came from serialized data
+        DynamicArray<const Gradient*> recordedGradients_;
+        // Word position of the command of each gradient
+        DynamicArray<vplUint> recordedPositions_;
+        vplUint decodedSize_;
+
+        // Not copyable
+        CommandBuffer(const CommandBuffer&);
+        CommandBuffer& operator=(const CommandBuffer&);
+    };
+}
+
+#endif
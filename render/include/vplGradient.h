@@ -23,6 +23,9 @@
 
 namespace vpl
 {   
+    // Color table shared by gradients with the same stops
+    struct ColorTable;
+
 	// Base class for gradients
     class VPL_API Gradient
     {
@@ -42,6 +45,18 @@ namespace vpl
 			cRadial
 		};
 
+		// How the colors between the stops are looked up
+		enum ColorLookup
+		{
+			// Table sized from the length of the gradient and the stops
+			cAdaptiveTable = 0,
+			// At most cSmallColorTableSize entries, stays in the L1 cache
+			cSmallTable,
+			// Two stops are interpolated per pixel without a table, slower
+			// but needs no memory. Otherwise like cAdaptiveTable.
+			cDirect
+		};
+
         struct Stop
         {
             Stop(float offset,const Color color):offset_(offset),color_(color){}
@@ -71,20 +86,16 @@ namespace vpl
 			}RadialGradientData;
 		};
 		
-		static const int cGradientColorTableSize = 1024;
-		static const int cMaxGradientPixels = 8192;
-
-		Gradient():spread_(cPad),type_(cLinear),colorTable_(0),
-			       gradientPixels_(0),valid_(true){}
+		// Color table sizes, always powers of two
+		static const int cMinColorTableSize = 64;
+		static const int cSmallColorTableSize = 256;
+		static const int cMaxColorTableSize = 4096;
+
+		Gradient():spread_(cPad),type_(cLinear),lookup_(cAdaptiveTable),
+			       colorTable_(0),colorTableSize_(0),sharedTable_(0),
+			       valid_(false){}
         
-		virtual ~Gradient()
-		{
-			if(colorTable_)
-				delete [] colorTable_;
-
-			if(gradientPixels_)
-				delete [] gradientPixels_;
-		}
+		virtual ~Gradient();
 
         inline void setSpread(Spread spread) 
 		{
@@ -95,18 +106,37 @@ namespace vpl
 		{
 			return spread_;
 		}
+
+		inline void setColorLookup(ColorLookup lookup)
+		{
+			lookup_ = lookup;
+			valid_ = false;
+		}
+
+		inline ColorLookup getColorLookup() const
+		{
+			return lookup_;
+		}
         
         inline void addStop(float offset,const Color& color)
         {
-            Stop stop(offset,color);
-            
-            // Verify input
+            // Verify input, not a number is taken as the start
             if(offset > 1.0f)
                 offset = 1.0f;
-            else if(offset < 0.0f)
+            else if(!(offset >= 0.0f))
                 offset = 0.0f;
             
-            stops_.add(stop);
+            stops_.add(Stop(offset,color));
+
+            // Keep the stops in order, after the ones at the same offset
+            for(vplUint i = stops_.getItemCount() - 1;
+                i > 0 && stops_[i - 1].offset_ > offset; i--)
+            {
+                Stop stop = stops_[i - 1];
+
+                stops_[i - 1] = stops_[i];
+                stops_[i] = stop;
+            }
 
 			valid_ = false;
         }
@@ -127,24 +157,45 @@ namespace vpl
 			return type_;
 		}
 
-		inline bool isValid()
+		inline bool isValid() const
 		{
 			return valid_;
 		}
 
+		// Get the color table of the stops from the cache, it is built
+		// when no other gradient has the same stops. After this the
+		// gradient is only read and can be shared between threads.
 		void generateGradient();
-		virtual vplUint32* fetchGradient(vplUint x,vplUint y,vplUint length) = 0;
+
+		// Generate unless it is valid already. Renderers call this before
+		// they fill, several of them may share the gradient on different
+		// threads
+		void validate();
+
+		// Write the length pixels from x,y to dest, needs a valid gradient
+		virtual void fetchGradient(vplUint32* dest,vplUint x,vplUint y,
+		                           vplUint length) const = 0;
 
     protected:
 
 		friend class Renderer;
+		friend class CommandBuffer;
+
+		// Distance in pixels over which the gradient goes through its stops
+		virtual float getLength() const = 0;
+
+		// Generate, the caller holds the gradient lock
+		void updateColorTable();
 
         Spread spread_;
 		Type type_;
+		ColorLookup lookup_;
         DynamicArray<Stop> stops_;
 		Data data_;
-		vplUint32* colorTable_;
-        vplUint32* gradientPixels_;
+		// Zero when the stops are interpolated directly
+		const vplUint32* colorTable_;
+		int colorTableSize_;
+		ColorTable* sharedTable_;
 		bool valid_;
     };
     
@@ -157,7 +208,11 @@ namespace vpl
 		LinearGradient(float x,float y,float dirX,float dirY);
 		~LinearGradient(){}
 
-		vplUint32* fetchGradient(vplUint x,vplUint y,vplUint length);
+		void fetchGradient(vplUint32* dest,vplUint x,vplUint y,vplUint length) const;
+
+	protected:
+
+		float getLength() const;
 
 	private:
 		 
@@ -174,11 +229,19 @@ namespace vpl
 		RadialGradient(float cx,float cy,float fx,float fy,float radius);
 		~RadialGradient(){}
 
-		vplUint32* fetchGradient(vplUint x,vplUint y,vplUint length);
+		void fetchGradient(vplUint32* dest,vplUint x,vplUint y,vplUint length) const;
+
+	protected:
+
+		float getLength() const;
 
 	private:
 
 		float c_;
+        // Focal point moved inside the circle
+        float focalX_;
+        float focalY_;
+        bool centered_;
     };
 }
 
@@ -21,26 +21,10 @@
 #include "vpl.h"
 #include "vplColor.h"
 #include "vplGradient.h"
+#include "vplBlendMode.h"
 
 namespace vpl
 {
-    // The different blending modes
-    enum BlendMode
-    {
-        cClear = 0,
-        cSrc,
-        cDest,
-        cSrcOverDest,
-        cDestOverSrc,
-        cSrcInDest,
-        cDestInSrc,
-        cSrcOutDest,
-        cDestOutSrc,
-        cSrcAtopDest,
-        cDestAtopSrc,
-        cSrcXorDest,
-    };
-
     class VPL_API Pen
     {
     public:
@@ -230,6 +214,8 @@ namespace vpl
         
 		void clear();
 		void clear(const Color& color);
+        // Clear the pixels inside rect, in pixel coordinates
+		void clear(const Color& color,const Rect& rect);
 
         inline vplUint getWidth() const
         {
@@ -268,9 +254,9 @@ namespace vpl
 	class VPL_API PathReference;
 	class VPL_API ScanLineList;
     class VPL_API EdgeGenerator;
-	class VPL_API NonZeroMaskBuffer;
-    struct VPL_API EvenOddMaskBuffer;
+    struct VPL_API FillState;
     struct VPL_API FillParameters;
+    class VPL_API BandRenderer;
 
     class VPL_API Renderer
     {
@@ -280,7 +266,21 @@ namespace vpl
             {
                 cSample8  = 8,
                 cSample16 = 16,
-                cSample32 = 32
+                cSample32 = 32,
+                // Exact area coverage of the pixels, edges
+                // are placed at 64 subpixel rows
+                cSampleArea = 64
+            };
+
+            // Work done by the last draw
+            struct Statistics
+            {
+                // Paths and edges generated again
+                vplUint numPaths_;
+                vplUint numEdges_;
+                // Fills and strokes, and the edges they rasterized
+                vplUint numFills_;
+                vplUint numFilledEdges_;
             };
 
             Renderer();
@@ -291,6 +291,9 @@ namespace vpl
 			void setTransform(const AffineMatrix& transform);
 			void transform(const AffineMatrix& transform);
             void setSamplingValue(Sampling sampling);
+            // Fill in horizontal bands using several threads, 1 fills on
+            // the calling thread only and 0 uses one thread per processor
+            void setNumberOfThreads(vplUint numThreads);
 			void compose(const PixelBuffer& src,BlendMode blendMode,
                          vplUint offsetX,vplUint offsetY);
 			PathReference* addPath(const Path* path,const Pen* pen);
@@ -298,8 +301,16 @@ namespace vpl
             PathReference* addPath(const Path* path,const Pen* pen,const Brush* brush);
             void removePath(PathReference** reference);
 			void clearPaths();
+            // Clear and draw area again on the next draw, in pixel
+            // coordinates
+            void invalidate(const Rect& area);
             void draw();
 
+            inline const Statistics& getStatistics() const
+            {
+                return statistics_;
+            }
+
         private:
 
 			void initialize();
@@ -309,12 +320,19 @@ namespace vpl
 					  ScanLineList* scanLines);
             
 			void drawNewEdges();
+            void drawReference(PathReference* reference);
+            void repaintDamage();
+            void setFillArea(const Rect& area);
+            void flushBands();
+            void resetStatistics();
             PathReference* allocateReference(const Path* path,
                                              const Pen* pen,
 								             const Brush* brush);
 			
 			void deAllocateReference(PathReference* reference);
+            void compactReferences();
 			void generateEdges(PathReference* reference);
+            AffineMatrix computeEdgeTransform() const;
 			
 			// Dimensions of backbuffer
 			vplUint width_;
@@ -324,17 +342,22 @@ namespace vpl
 			// The backbuffer
             PixelBuffer* target_;
             EdgeGenerator* edgeGenerator_;
-            EvenOddMaskBuffer* evenOddMaskBuffer_;
-            NonZeroMaskBuffer* nonZeroMaskBuffer_;
+            FillState* fillState_;
             FillParameters* fillParameters_;
+            BandRenderer* bandRenderer_;
             vplUchar subPixelCount_;
             vplUchar subPixelShift_;
             Rect clipRect_;
-			bool targetUpdated_;
 			bool transformUpdated_;
-			List<PathReference*> references_;
-            List<PathReference*> newReferences_;
+            // Area of the target that must be cleared and drawn again
+            Rect damage_;
+            // Paths in drawing order, the ones not drawn yet at the end.
+            // Removed paths leave a hole until the next draw
+			DynamicArray<PathReference*> references_;
+            vplUint firstNewReference_;
+            vplUint numRemovedReferences_;
 			AffineMatrix transform_;
+            Statistics statistics_;
     };
 
     VPL_API const char* toString(Stroker::EndType t);
@@ -0,0 +1,310 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "vplBandRenderer.h"
+
+namespace vpl
+{
+    class BandRenderer::Worker:public Thread
+    {
+    public:
+
+        Worker(BandRenderer* owner):owner_(owner),
+                                    generation_(owner->generation_){}
+        ~Worker(){}
+
+    protected:
+
+        void run()
+        {
+            while(owner_->waitForWork(generation_))
+            {
+                state_.setSubPixelCount(owner_->params_.subPixelCount_);
+
+                owner_->fillBands(&state_);
+                owner_->finishWork();
+            }
+        }
+
+    private:
+
+        BandRenderer* owner_;
+        // Last render this worker took part in
+        vplUint generation_;
+        FillState state_;
+    };
+
+    // Bands of params from its first line down
+    static inline int getNumberOfBands(const FillParameters& params)
+    {
+        if(params.lastLine_ < params.firstLine_)
+            return 0;
+
+        return (params.lastLine_ - params.firstLine_)/BandRenderer::cBandHeight + 1;
+    }
+
+    // Bands an edge starting on line reaches into from above, none when
+    // lastBand is less than firstBand
+    static inline void getCrossedBands(int line,const Edge& edge,
+                                       const FillParameters& params,int numBands,
+                                       int& firstBand,int& lastBand)
+    {
+        int end = (edge.lastScanLine_ >> params.subPixelShift_) - params.firstLine_;
+
+        firstBand = 0;
+        lastBand = -1;
+
+        if(line >= params.firstLine_)
+            firstBand = (line - params.firstLine_)/BandRenderer::cBandHeight + 1;
+
+        if(end >= 0)
+            lastBand = end/BandRenderer::cBandHeight;
+
+        if(lastBand >= numBands)
+            lastBand = numBands - 1;
+    }
+
+    BandRenderer::BandRenderer():target_(0),numBands_(0),nextBand_(0),
+                                 generation_(0),numBusyWorkers_(0),
+                                 stopping_(false)
+    {
+    }
+
+    BandRenderer::~BandRenderer()
+    {
+        stopWorkers();
+    }
+
+    void BandRenderer::setNumberOfThreads(vplUint numThreads)
+    {
+        if(numThreads < 1)
+            numThreads = 1;
+
+        // The calling thread is the first one
+        if(workers_.getItemCount() == numThreads - 1)
+            return;
+
+        stopWorkers();
+        startWorkers(numThreads - 1);
+    }
+
+    void BandRenderer::startWorkers(vplUint numWorkers)
+    {
+        stopping_ = false;
+
+        for(vplUint i = 0; i < numWorkers; i++)
+        {
+            Worker* worker = new Worker(this);
+
+            if(!worker->start())
+            {
+                delete worker;
+                break;
+            }
+
+            workers_.add(worker);
+        }
+    }
+
+    void BandRenderer::stopWorkers()
+    {
+        {
+            MutexLocker locker(mutex_);
+
+            stopping_ = true;
+            workCondition_.broadcast();
+        }
+
+        for(vplUint i = 0; i < workers_.getItemCount(); i++)
+        {
+            workers_[i]->join();
+
+            delete workers_[i];
+        }
+
+        workers_.clear();
+    }
+
+    bool BandRenderer::waitForWork(vplUint& generation)
+    {
+        MutexLocker locker(mutex_);
+
+        while(!stopping_ && generation == generation_)
+            workCondition_.wait(mutex_);
+
+        generation = generation_;
+
+        return !stopping_;
+    }
+
+    void BandRenderer::finishWork()
+    {
+        MutexLocker locker(mutex_);
+
+        if(--numBusyWorkers_ == 0)
+            doneCondition_.signal();
+    }
+
+    // Bucket the edges of the job by the bands they reach into from
+    // above, so a band does not have to search the edges above it
+    void BandRenderer::add(const FillJob& job,const FillParameters& params)
+    {
+        jobs_.add(job);
+
+        ScanLineList* edges = job.edges_;
+        int numBands = getNumberOfBands(params);
+        vplUint first = bandStarts_.getItemCount();
+
+        bandStarts_.resize(first + numBands + 1);
+
+        vplUint* starts = bandStarts_.getContents() + first;
+
+        for(int i = 0; i <= numBands; i++)
+            starts[i] = 0;
+
+        int lastLine = edges->getMax();
+
+        if(lastLine > params.lastLine_)
+            lastLine = params.lastLine_;
+
+        // Count the edges of each band, one past it
+        for(int y = edges->getMin(); y <= lastLine; ++y)
+        {
+            const Edge* lastEdge = edges->getLineEnd(y);
+
+            for(const Edge* edge = edges->getLine(y); edge != lastEdge; ++edge)
+            {
+                int firstBand;
+                int lastBand;
+
+                getCrossedBands(y,*edge,params,numBands,firstBand,lastBand);
+
+                for(int band = firstBand; band <= lastBand; band++)
+                    starts[band + 1]++;
+            }
+        }
+
+        // Turn counts into positions in the edge array
+        vplUint base = crossingEdges_.getItemCount();
+
+        starts[0] = base;
+
+        for(int i = 1; i <= numBands; i++)
+            starts[i] += starts[i - 1];
+
+        if(starts[numBands] == base)
+            return;
+
+        crossingEdges_.resize(starts[numBands]);
+        bandCursors_.resize(numBands);
+
+        vplUint* cursors = bandCursors_.getContents();
+        const Edge** crossing = crossingEdges_.getContents();
+
+        for(int i = 0; i < numBands; i++)
+            cursors[i] = starts[i];
+
+        for(int y = edges->getMin(); y <= lastLine; ++y)
+        {
+            const Edge* lastEdge = edges->getLineEnd(y);
+
+            for(const Edge* edge = edges->getLine(y); edge != lastEdge; ++edge)
+            {
+                int firstBand;
+                int lastBand;
+
+                getCrossedBands(y,*edge,params,numBands,firstBand,lastBand);
+
+                for(int band = firstBand; band <= lastBand; band++)
+                    crossing[cursors[band]++] = edge;
+            }
+        }
+    }
+
+    void BandRenderer::render(PixelBuffer* target,const FillParameters& params,
+                              FillState* state)
+    {
+        target_ = target;
+        params_ = params;
+        params_.hasCrossingEdges_ = true;
+
+        numBands_ = getNumberOfBands(params);
+        nextBand_ = 0;
+
+        // Wake the workers, then fill bands here too
+        {
+            MutexLocker locker(mutex_);
+
+            numBusyWorkers_ = workers_.getItemCount();
+            ++generation_;
+
+            workCondition_.broadcast();
+        }
+
+        fillBands(state);
+
+        {
+            MutexLocker locker(mutex_);
+
+            while(numBusyWorkers_ > 0)
+                doneCondition_.wait(mutex_);
+        }
+
+        jobs_.clear();
+        crossingEdges_.clear();
+        bandStarts_.clear();
+    }
+
+    void BandRenderer::fillBands(FillState* state)
+    {
+        FillParameters params = params_;
+        int band;
+
+        while(getNextBand(params,band))
+        {
+            for(vplUint i = 0; i < jobs_.getItemCount(); i++)
+            {
+                const vplUint* starts = bandStarts_.getContents() +
+                                        i*(numBands_ + 1) + band;
+
+                params.crossingEdges_ = crossingEdges_.getContents() + starts[0];
+                params.numCrossingEdges_ = starts[1] - starts[0];
+
+                fillPath(jobs_[i],target_,params,state);
+            }
+        }
+    }
+
+    bool BandRenderer::getNextBand(FillParameters& params,int& band)
+    {
+        MutexLocker locker(mutex_);
+
+        if(nextBand_ >= numBands_)
+            return false;
+
+        band = nextBand_++;
+
+        params.firstLine_ = params_.firstLine_ + band*cBandHeight;
+        params.lastLine_ = params.firstLine_ + cBandHeight - 1;
+
+        if(params.lastLine_ > params_.lastLine_)
+            params.lastLine_ = params_.lastLine_;
+
+        return true;
+    }
+}
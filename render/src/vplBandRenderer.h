@@ -0,0 +1,95 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VPL_BAND_RENDERER_H_INCLUDED_
+#define VPL_BAND_RENDERER_H_INCLUDED_
+
+#include "vplConfig.h"
+#include "vplArray.h"
+#include "vplThread.h"
+#include "vplFill.h"
+
+namespace vpl
+{
+    // Fills queued edge lists in horizontal bands on several threads.
+    // Every band is filled in queue order, so the result is identical
+    // to filling the queue on one thread. The worker threads are kept
+    // and wait for the next render between draws.
+    class BandRenderer
+    {
+    public:
+
+        // Height of a band in pixels
+        static const int cBandHeight = 32;
+
+        BandRenderer();
+        ~BandRenderer();
+
+        // Number of threads including the calling thread
+        void setNumberOfThreads(vplUint numThreads);
+
+        inline vplUint getNumberOfThreads() const
+        {
+            return workers_.getItemCount() + 1;
+        }
+
+        // Queue a fill, params must be the ones later passed to render
+        void add(const FillJob& job,const FillParameters& params);
+
+        // Fill and empty the queue, state is used by the calling thread
+        void render(PixelBuffer* target,const FillParameters& params,
+                    FillState* state);
+
+    private:
+
+        class Worker;
+
+        void startWorkers(vplUint numWorkers);
+        void stopWorkers();
+
+        // Called by the workers, wait until there is a render newer than
+        // generation. Returns false when the worker should stop
+        bool waitForWork(vplUint& generation);
+        void finishWork();
+
+        // Fill bands until there are none left
+        void fillBands(FillState* state);
+        bool getNextBand(FillParameters& params,int& band);
+
+        DynamicArray<FillJob> jobs_;
+        // Edges that reach into a band from above, bucketed per job when
+        // it is queued. Band b of job j has the edges from
+        // bandStarts_[j*(numBands + 1) + b] up to the next start
+        DynamicArray<const Edge*> crossingEdges_;
+        DynamicArray<vplUint> bandStarts_;
+        DynamicArray<vplUint> bandCursors_;
+        DynamicArray<Worker*> workers_;
+        Mutex mutex_;
+        Condition workCondition_;
+        Condition doneCondition_;
+        PixelBuffer* target_;
+        FillParameters params_;
+        int numBands_;
+        int nextBand_;
+        // Bumped by every render the workers take part in
+        vplUint generation_;
+        vplUint numBusyWorkers_;
+        bool stopping_;
+    };
+}
+#endif
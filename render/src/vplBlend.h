@@ -20,6 +20,7 @@
 
 #include "vplRender.h"
 #include "vplColorHelper.h"
+#include "vplBlendKernels.h"
 
 namespace vpl
 {
@@ -63,23 +64,38 @@ namespace vpl
 		vplUint32 color_;
     };
 
+    // Gradient blenders fetch the gradient in pieces of at most this many
+    // pixels, to a buffer owned by the fill. The gradient itself is only
+    // read, so one can be used by several fills at once.
+    static const vplUint cGradientSpanLength = 256;
+
     class VPL_API SrcGradientBlender
     {
     public:
 
-        SrcGradientBlender():gradient_(0){}
+        SrcGradientBlender():gradient_(0),pixels_(0){}
         ~SrcGradientBlender(){}
 
         inline void blend(vplUint32* dest,vplUint x,vplUint y,vplUint count) const
         {
-			vplUint32* gradientPixels = gradient_->fetchGradient(x,y,count);
+            while(count > 0)
+            {
+                vplUint length = count < cGradientSpanLength ? count : cGradientSpanLength;
+
+                gradient_->fetchGradient(pixels_,x,y,length);
 
-            vplMemCopy(dest,gradientPixels,count);
+                vplMemCopy(dest,pixels_,length);
+
+                dest += length;
+                x += length;
+                count -= length;
+            }
         }
 
-        inline void setGradient(Gradient* gradient)
+        inline void setGradient(const Gradient* gradient,vplUint32* pixels)
 		{
 			gradient_ = gradient;
+			pixels_ = pixels;
 		}
 
 		inline vplUint32 getColor()
@@ -89,7 +105,8 @@ namespace vpl
 
     private:
 
-        Gradient* gradient_;
+        const Gradient* gradient_;
+        vplUint32* pixels_;
     };
 
     // Destination blend is like a nop
@@ -129,16 +146,17 @@ namespace vpl
     {
     public:
 
-        DestGradientBlender():gradient_(0){}
+        DestGradientBlender():gradient_(0),pixels_(0){}
         ~DestGradientBlender(){}
 
         inline void blend(vplUint32*,vplUint,vplUint,vplUint) const
         {
         }
 
-        inline void setGradient(Gradient* gradient)
+        inline void setGradient(const Gradient* gradient,vplUint32* pixels)
 		{
 			gradient_ = gradient;
+			pixels_ = pixels;
 		}
 
 		inline vplUint32 getColor()
@@ -149,7 +167,8 @@ namespace vpl
 
     private:
 
-        Gradient* gradient_;
+        const Gradient* gradient_;
+        vplUint32* pixels_;
     };
 
     // Ar = As + Ad * (1 - As)
@@ -169,7 +188,9 @@ namespace vpl
 				vplMemFill32(dest,color_,count);
 			else
 			{
-				for(vplUint i = 0; i < count; i++)
+				vplUint i = getBlendKernels().color_[cSrcOverDest](dest,color_,count);
+
+				for(; i < count; i++)
 					dest[i] = color_ + multiplyPixel(dest[i],oneMinusAlpha);
 			}
         }
@@ -182,7 +203,9 @@ namespace vpl
 				vplMemCopy(dest,src,count);
 			else
 			{
-				for(vplUint i = 0; i < count; i++)
+				vplUint i = getBlendKernels().srcOverScaled_(dest,src,oneMinusAlpha,count);
+
+				for(; i < count; i++)
 					dest[i] = src[i] + multiplyPixel(dest[i],oneMinusAlpha);
 			}
         }
@@ -206,23 +229,35 @@ namespace vpl
     {
     public:
 
-        SrcOverDestGradientBlender():gradient_(0){}
+        SrcOverDestGradientBlender():gradient_(0),pixels_(0){}
         ~SrcOverDestGradientBlender(){}
 
         inline void blend(vplUint32* dest,vplUint x,vplUint y,vplUint count) const
         {
-            vplUint32* gradientPixels = gradient_->fetchGradient(x,y,count);
-
-            for(vplUint i = 0; i < count; i++)
+            while(count > 0)
             {
-                dest[i] = gradientPixels[i] + \
-					multiplyPixel(dest[i],getAlphaChannelFromRGBA(~gradientPixels[i]));
+                vplUint length = count < cGradientSpanLength ? count : cGradientSpanLength;
+
+                gradient_->fetchGradient(pixels_,x,y,length);
+
+                vplUint i = getBlendKernels().span_[cSrcOverDest](dest,pixels_,length);
+
+                for(; i < length; i++)
+                {
+                    dest[i] = pixels_[i] + \
+    					multiplyPixel(dest[i],getAlphaChannelFromRGBA(~pixels_[i]));
+                }
+
+                dest += length;
+                x += length;
+                count -= length;
             }
         }
 
-		inline void setGradient(Gradient* gradient)
+		inline void setGradient(const Gradient* gradient,vplUint32* pixels)
 		{
 			gradient_ = gradient;
+			pixels_ = pixels;
 		}
 
 		inline vplUint32 getColor()
@@ -232,7 +267,8 @@ namespace vpl
 
     private:
 
-        Gradient* gradient_;
+        const Gradient* gradient_;
+        vplUint32* pixels_;
     };
     // Ar = As * (1 - Ad) + Ad
     // Cr = Cs * (1 - Ad) + Cd
@@ -245,13 +281,17 @@ namespace vpl
 
         inline void blend(vplUint32* dest,vplUint,vplUint,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().color_[cDestOverSrc](dest,color_,count);
+
+            for(; i < count; i++)
 				dest[i] =  dest[i] + multiplyPixel(color_,getAlphaChannelFromRGBA(~dest[i]));
 
         }
         inline void blend(vplUint32* dest,const vplUint32* src,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().span_[cDestOverSrc](dest,src,count);
+
+            for(; i < count; i++)
 				dest[i] = dest[i] + multiplyPixel(src[i],getAlphaChannelFromRGBA(~dest[i]));
         }
 
@@ -274,24 +314,35 @@ namespace vpl
     {
     public:
 
-        DestOverSrcGradientBlender():gradient_(0){}
+        DestOverSrcGradientBlender():gradient_(0),pixels_(0){}
         ~DestOverSrcGradientBlender(){}
 
         inline void blend(vplUint32* dest,vplUint x,vplUint y,vplUint count) const
         {
-            vplUint32* gradientPixels = gradient_->fetchGradient(x,y,count);
-
-            for(vplUint i = 0; i < count; i++)
+            while(count > 0)
             {
-				dest[i] = dest[i] + \
-					multiplyPixel(gradientPixels[i],getAlphaChannelFromRGBA(~dest[i]));
-            }
+                vplUint length = count < cGradientSpanLength ? count : cGradientSpanLength;
+
+                gradient_->fetchGradient(pixels_,x,y,length);
+
+                vplUint i = getBlendKernels().span_[cDestOverSrc](dest,pixels_,length);
+
+                for(; i < length; i++)
+                {
+    				dest[i] = dest[i] + \
+    					multiplyPixel(pixels_[i],getAlphaChannelFromRGBA(~dest[i]));
+                }
 
+                dest += length;
+                x += length;
+                count -= length;
+            }
         }
 
-		inline void setGradient(Gradient* gradient)
+		inline void setGradient(const Gradient* gradient,vplUint32* pixels)
 		{
 			gradient_ = gradient;
+			pixels_ = pixels;
 		}
 
 		inline vplUint32 getColor()
@@ -302,7 +353,8 @@ namespace vpl
 
     private:
 
-        Gradient* gradient_;
+        const Gradient* gradient_;
+        vplUint32* pixels_;
     };
 
     // Ar = As * Ad
@@ -316,13 +368,17 @@ namespace vpl
 
         inline void blend(vplUint32* dest,vplUint,vplUint,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().color_[cSrcInDest](dest,color_,count);
+
+            for(; i < count; i++)
                 dest[i] = multiplyPixel(color_,getAlphaChannelFromRGBA( dest[i]));
         }
 
         inline void blend(vplUint32* dest,const vplUint32* src,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().span_[cSrcInDest](dest,src,count);
+
+            for(; i < count; i++)
 				dest[i] = multiplyPixel(src[i],getAlphaChannelFromRGBA(dest[i]));
         }
 
@@ -345,20 +401,32 @@ namespace vpl
     {
     public:
 
-        SrcInDestGradientBlender():gradient_(0){}
+        SrcInDestGradientBlender():gradient_(0),pixels_(0){}
         ~SrcInDestGradientBlender(){}
 
         inline void blend(vplUint32* dest,vplUint x,vplUint y,vplUint count) const
         {
-           vplUint32* gradientPixels = gradient_->fetchGradient(x,y,count);
+            while(count > 0)
+            {
+                vplUint length = count < cGradientSpanLength ? count : cGradientSpanLength;
+
+                gradient_->fetchGradient(pixels_,x,y,length);
 
-            for(vplUint i = 0; i < count; i++)
-				dest[i] = multiplyPixel(gradientPixels[i],getAlphaChannelFromRGBA(dest[i]));
+                vplUint i = getBlendKernels().span_[cSrcInDest](dest,pixels_,length);
+
+                for(; i < length; i++)
+    				dest[i] = multiplyPixel(pixels_[i],getAlphaChannelFromRGBA(dest[i]));
+
+                dest += length;
+                x += length;
+                count -= length;
+            }
         }
 
-		inline void setGradient(Gradient* gradient)
+		inline void setGradient(const Gradient* gradient,vplUint32* pixels)
 		{
 			gradient_ = gradient;
+			pixels_ = pixels;
 		}
 
 		inline vplUint32 getColor()
@@ -368,7 +436,8 @@ namespace vpl
 
     private:
 
-        Gradient* gradient_;
+        const Gradient* gradient_;
+        vplUint32* pixels_;
     };
 
     // Ar = Ad * As
@@ -382,13 +451,17 @@ namespace vpl
 
         inline void blend(vplUint32* dest,vplUint,vplUint,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().color_[cDestInSrc](dest,color_,count);
+
+            for(; i < count; i++)
                 dest[i] = multiplyPixel(dest[i],getAlphaChannelFromRGBA(color_));
         }
 
         inline void blend(vplUint32* dest,const vplUint32* src,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().span_[cDestInSrc](dest,src,count);
+
+            for(; i < count; i++)
                 dest[i] = multiplyPixel(dest[i],getAlphaChannelFromRGBA(src[i]));
         }
 
@@ -411,21 +484,32 @@ namespace vpl
     {
     public:
 
-        DestInSrcGradientBlender():gradient_(0){}
+        DestInSrcGradientBlender():gradient_(0),pixels_(0){}
         ~DestInSrcGradientBlender(){}
 
         inline void blend(vplUint32* dest,vplUint x,vplUint y,vplUint count) const
         {
-            vplUint32* gradientPixels = gradient_->fetchGradient(x,y,count);
+            while(count > 0)
+            {
+                vplUint length = count < cGradientSpanLength ? count : cGradientSpanLength;
+
+                gradient_->fetchGradient(pixels_,x,y,length);
+
+                vplUint i = getBlendKernels().span_[cDestInSrc](dest,pixels_,length);
 
-            for(vplUint i = 0; i < count; i++)
-                dest[i] = multiplyPixel(dest[i],getAlphaChannelFromRGBA(gradientPixels[i]));
+                for(; i < length; i++)
+                    dest[i] = multiplyPixel(dest[i],getAlphaChannelFromRGBA(pixels_[i]));
 
+                dest += length;
+                x += length;
+                count -= length;
+            }
         }
 
-		inline void setGradient(Gradient* gradient)
+		inline void setGradient(const Gradient* gradient,vplUint32* pixels)
 		{
 			gradient_ = gradient;
+			pixels_ = pixels;
 		}
 
 		inline vplUint32 getColor()
@@ -435,7 +519,8 @@ namespace vpl
 
     private:
 
-        Gradient* gradient_;
+        const Gradient* gradient_;
+        vplUint32* pixels_;
     };
 
     // Ar = As * (1 - Ad)
@@ -449,13 +534,17 @@ namespace vpl
 
         inline void blend(vplUint32* dest,vplUint,vplUint,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().color_[cSrcOutDest](dest,color_,count);
+
+            for(; i < count; i++)
                 dest[i] = multiplyPixel(color_,getAlphaChannelFromRGBA(~dest[i]));
         }
 
         inline void blend(vplUint32* dest,const vplUint32* src,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().span_[cSrcOutDest](dest,src,count);
+
+            for(; i < count; i++)
                 dest[i] = multiplyPixel(src[i],getAlphaChannelFromRGBA(~dest[i]));
         }
 
@@ -478,20 +567,32 @@ namespace vpl
     {
     public:
 
-        SrcOutDestGradientBlender():gradient_(0){}
+        SrcOutDestGradientBlender():gradient_(0),pixels_(0){}
         ~SrcOutDestGradientBlender(){}
 
         inline void blend(vplUint32* dest,vplUint x,vplUint y,vplUint count) const
         {
-            vplUint32* gradientPixels = gradient_->fetchGradient(x,y,count);
+            while(count > 0)
+            {
+                vplUint length = count < cGradientSpanLength ? count : cGradientSpanLength;
+
+                gradient_->fetchGradient(pixels_,x,y,length);
+
+                vplUint i = getBlendKernels().span_[cSrcOutDest](dest,pixels_,length);
 
-            for(vplUint i = 0; i < count; i++)
-				dest[i] = multiplyPixel(gradientPixels[i],getAlphaChannelFromRGBA(~dest[i]));
+                for(; i < length; i++)
+    				dest[i] = multiplyPixel(pixels_[i],getAlphaChannelFromRGBA(~dest[i]));
+
+                dest += length;
+                x += length;
+                count -= length;
+            }
         }
 
-		inline void setGradient(Gradient* gradient)
+		inline void setGradient(const Gradient* gradient,vplUint32* pixels)
 		{
 			gradient_ = gradient;
+			pixels_ = pixels;
 		}
 
 		inline vplUint32 getColor()
@@ -501,7 +602,8 @@ namespace vpl
 
     private:
 
-        Gradient* gradient_;
+        const Gradient* gradient_;
+        vplUint32* pixels_;
     };
 
     // Ar = Ad * (1 - As)
@@ -515,13 +617,17 @@ namespace vpl
 
         inline void blend(vplUint32* dest,vplUint,vplUint,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().color_[cDestOutSrc](dest,color_,count);
+
+            for(; i < count; i++)
                 dest[i] = multiplyPixel(dest[i],getAlphaChannelFromRGBA(~color_));
         }
 
         inline void blend(vplUint32* dest,const vplUint32* src,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().span_[cDestOutSrc](dest,src,count);
+
+            for(; i < count; i++)
                 dest[i] = multiplyPixel(dest[i],getAlphaChannelFromRGBA(~src[i]));
         }
 
@@ -544,23 +650,35 @@ namespace vpl
     {
     public:
 
-        DestOutSrcGradientBlender():gradient_(0){}
+        DestOutSrcGradientBlender():gradient_(0),pixels_(0){}
         ~DestOutSrcGradientBlender(){}
 
         inline void blend(vplUint32* dest,vplUint x,vplUint y,vplUint count) const
         {
-           vplUint32* gradientPixels = gradient_->fetchGradient(x,y,count);
+            while(count > 0)
+            {
+                vplUint length = count < cGradientSpanLength ? count : cGradientSpanLength;
 
-            for(vplUint i = 0; i < count; i++)
-			{
-                dest[i] = multiplyPixel(dest[i],
-					                    getAlphaChannelFromRGBA(~gradientPixels[i]));
-			}
+                gradient_->fetchGradient(pixels_,x,y,length);
+
+                vplUint i = getBlendKernels().span_[cDestOutSrc](dest,pixels_,length);
+
+                for(; i < length; i++)
+    			{
+                    dest[i] = multiplyPixel(dest[i],
+    					                    getAlphaChannelFromRGBA(~pixels_[i]));
+    			}
+
+                dest += length;
+                x += length;
+                count -= length;
+            }
         }
 
-		inline void setGradient(Gradient* gradient)
+		inline void setGradient(const Gradient* gradient,vplUint32* pixels)
 		{
 			gradient_ = gradient;
+			pixels_ = pixels;
 		}
 
 		inline vplUint32 getColor()
@@ -570,7 +688,8 @@ namespace vpl
 
     private:
 
-        Gradient* gradient_;
+        const Gradient* gradient_;
+        vplUint32* pixels_;
     };
 
     // Ar = As * Ad + Ad * (1 - As)
@@ -587,7 +706,9 @@ namespace vpl
         {
             vplUint32 inverseAlpha = getAlphaChannelFromRGBA(~color_);
 
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().color_[cSrcAtopDest](dest,color_,count);
+
+            for(; i < count; i++)
             {
                 dest[i] = interpolatePixel(color_,
 					                       getAlphaChannelFromRGBA(dest[i]),
@@ -599,7 +720,9 @@ namespace vpl
 
         inline void blend(vplUint32* dest,const vplUint32* src,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().span_[cSrcAtopDest](dest,src,count);
+
+            for(; i < count; i++)
             {
                 dest[i] = interpolatePixel(src[i],
 					                       getAlphaChannelFromRGBA(dest[i]),
@@ -626,25 +749,37 @@ namespace vpl
     {
     public:
 
-        SrcAtopDestGradientBlender():gradient_(0){}
+        SrcAtopDestGradientBlender():gradient_(0),pixels_(0){}
         ~SrcAtopDestGradientBlender(){}
 
         inline void blend(vplUint32* dest,vplUint x,vplUint y,vplUint count) const
         {
-           vplUint32* gradientPixels = gradient_->fetchGradient(x,y,count);
-
-            for(vplUint i = 0; i < count; i++)
+            while(count > 0)
             {
-                dest[i] = interpolatePixel(gradientPixels[i],
-					                       getAlphaChannelFromRGBA(dest[i]),
-										   dest[i],
-										   getAlphaChannelFromRGBA(~gradientPixels[i]));
+                vplUint length = count < cGradientSpanLength ? count : cGradientSpanLength;
+
+                gradient_->fetchGradient(pixels_,x,y,length);
+
+                vplUint i = getBlendKernels().span_[cSrcAtopDest](dest,pixels_,length);
+
+                for(; i < length; i++)
+                {
+                    dest[i] = interpolatePixel(pixels_[i],
+    					                       getAlphaChannelFromRGBA(dest[i]),
+    										   dest[i],
+    										   getAlphaChannelFromRGBA(~pixels_[i]));
+                }
+
+                dest += length;
+                x += length;
+                count -= length;
             }
         }
 
-		inline void setGradient(Gradient* gradient)
+		inline void setGradient(const Gradient* gradient,vplUint32* pixels)
 		{
 			gradient_ = gradient;
+			pixels_ = pixels;
 		}
 
 		inline vplUint32 getColor()
@@ -654,7 +789,8 @@ namespace vpl
 
     private:
 
-        Gradient* gradient_;
+        const Gradient* gradient_;
+        vplUint32* pixels_;
     };
 
     // Ar = As * (1 - Ad) + Ad * As
@@ -669,7 +805,9 @@ namespace vpl
 
         inline void blend(vplUint32* dest,vplUint,vplUint,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().color_[cDestAtopSrc](dest,color_,count);
+
+            for(; i < count; i++)
             {
                 dest[i] = interpolatePixel(dest[i],
 					                       getAlphaChannelFromRGBA(color_),
@@ -680,7 +818,9 @@ namespace vpl
 
         inline void blend(vplUint32* dest,const vplUint32* src,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().span_[cDestAtopSrc](dest,src,count);
+
+            for(; i < count; i++)
             {
                 dest[i] = interpolatePixel(dest[i],
 					                       getAlphaChannelFromRGBA(src[i]),
@@ -708,25 +848,37 @@ namespace vpl
     {
     public:
 
-        DestAtopSrcGradientBlender():gradient_(0){}
+        DestAtopSrcGradientBlender():gradient_(0),pixels_(0){}
         ~DestAtopSrcGradientBlender(){}
 
         inline void blend(vplUint32* dest,vplUint x,vplUint y,vplUint count) const
         {
-            vplUint32* gradientPixels = gradient_->fetchGradient(x,y,count);
-
-            for(vplUint i = 0; i < count; i++)
+            while(count > 0)
             {
-                dest[i] = interpolatePixel(dest[i],
-					                       getAlphaChannelFromRGBA(gradientPixels[i]),
-										   gradientPixels[i],
-										   getAlphaChannelFromRGBA(~dest[i]));
+                vplUint length = count < cGradientSpanLength ? count : cGradientSpanLength;
+
+                gradient_->fetchGradient(pixels_,x,y,length);
+
+                vplUint i = getBlendKernels().span_[cDestAtopSrc](dest,pixels_,length);
+
+                for(; i < length; i++)
+                {
+                    dest[i] = interpolatePixel(dest[i],
+    					                       getAlphaChannelFromRGBA(pixels_[i]),
+    										   pixels_[i],
+    										   getAlphaChannelFromRGBA(~dest[i]));
+                }
+
+                dest += length;
+                x += length;
+                count -= length;
             }
         }
 
-		inline void setGradient(Gradient* gradient)
+		inline void setGradient(const Gradient* gradient,vplUint32* pixels)
 		{
 			gradient_ = gradient;
+			pixels_ = pixels;
 		}
 
 		inline vplUint32 getColor()
@@ -736,7 +888,8 @@ namespace vpl
 
     private:
 
-        Gradient* gradient_;
+        const Gradient* gradient_;
+        vplUint32* pixels_;
     };
 
     // Ar = As * (1 - Ad) + Ad * (1 - As)
@@ -752,7 +905,9 @@ namespace vpl
         {
             vplUint32 inverseAlpha = getAlphaChannelFromRGBA(~color_);
 
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().color_[cSrcXorDest](dest,color_,count);
+
+            for(; i < count; i++)
             {
                 dest[i] = interpolatePixel(color_,
 					                       getAlphaChannelFromRGBA(~dest[i]),
@@ -763,7 +918,9 @@ namespace vpl
 
         inline void blend(vplUint32* dest,const vplUint32* src,vplUint count) const
         {
-            for(vplUint i = 0; i < count; i++)
+            vplUint i = getBlendKernels().span_[cSrcXorDest](dest,src,count);
+
+            for(; i < count; i++)
             {
                 dest[i] = interpolatePixel(src[i],
 					                       getAlphaChannelFromRGBA(~dest[i]),
@@ -791,25 +948,37 @@ namespace vpl
     {
     public:
 
-        SrcXorDestGradientBlender():gradient_(0){}
+        SrcXorDestGradientBlender():gradient_(0),pixels_(0){}
         ~SrcXorDestGradientBlender(){}
 
         inline void blend(vplUint32* dest,vplUint x,vplUint y,vplUint count) const
         {
-            vplUint32* gradientPixels = gradient_->fetchGradient(x,y,count);
-
-            for(vplUint i = 0; i < count; i++)
+            while(count > 0)
             {
-                dest[i] = interpolatePixel(gradientPixels[i],
-					                       getAlphaChannelFromRGBA(~dest[i]),
-										   dest[i],
-										   getAlphaChannelFromRGBA(~gradientPixels[i]));
+                vplUint length = count < cGradientSpanLength ? count : cGradientSpanLength;
+
+                gradient_->fetchGradient(pixels_,x,y,length);
+
+                vplUint i = getBlendKernels().span_[cSrcXorDest](dest,pixels_,length);
+
+                for(; i < length; i++)
+                {
+                    dest[i] = interpolatePixel(pixels_[i],
+    					                       getAlphaChannelFromRGBA(~dest[i]),
+    										   dest[i],
+    										   getAlphaChannelFromRGBA(~pixels_[i]));
+                }
+
+                dest += length;
+                x += length;
+                count -= length;
             }
         }
 
-		inline void setGradient(Gradient* gradient)
+		inline void setGradient(const Gradient* gradient,vplUint32* pixels)
 		{
 			gradient_ = gradient;
+			pixels_ = pixels;
 		}
 
 		inline vplUint32 getColor()
@@ -819,7 +988,8 @@ namespace vpl
 
     private:
 
-        Gradient* gradient_;
+        const Gradient* gradient_;
+        vplUint32* pixels_;
     };
 
 	// Ar = 0
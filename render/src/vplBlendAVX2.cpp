@@ -0,0 +1,286 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <immintrin.h>
+#include "vplBlendOps.h"
+
+// Compiled with AVX2 enabled, only called when the processor has it
+namespace
+{
+    // AVX2, eight pixels at a time
+    struct AVX2Vector
+    {
+        typedef __m256i Type;
+
+        static const vplUint cWidth = 8;
+
+        static inline Type load(const vplUint32* p)
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        }
+
+        static inline void store(vplUint32* p,Type a)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),a);
+        }
+
+        static inline Type set1(vplUint32 a)
+        {
+            return _mm256_set1_epi32(static_cast<int>(a));
+        }
+
+        static inline Type add(Type a,Type b)     {return _mm256_add_epi32(a,b);}
+        static inline Type andOp(Type a,Type b)   {return _mm256_and_si256(a,b);}
+        static inline Type orOp(Type a,Type b)    {return _mm256_or_si256(a,b);}
+        static inline Type xorOp(Type a,Type b)   {return _mm256_xor_si256(a,b);}
+        static inline Type mullo16(Type a,Type b) {return _mm256_mullo_epi16(a,b);}
+        static inline Type srli(Type a,int n)     {return _mm256_srli_epi32(a,n);}
+        static inline Type slli(Type a,int n)     {return _mm256_slli_epi32(a,n);}
+    };
+
+    // Bits set in each lane
+    inline __m256i popcount(__m256i a)
+    {
+        const __m256i table = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                               0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+        const __m256i low = _mm256_set1_epi8(0x0f);
+
+        __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(table,_mm256_and_si256(a,low)),
+                                        _mm256_shuffle_epi8(table,_mm256_and_si256(_mm256_srli_epi16(a,4),low)));
+
+        return _mm256_madd_epi16(_mm256_maddubs_epi16(bytes,_mm256_set1_epi8(1)),
+                                 _mm256_set1_epi16(1));
+    }
+
+    inline vplUint32 popcount(vplUint32 a)
+    {
+        a = a - ((a >> 1) & 0x55555555);
+        a = (a & 0x33333333) + ((a >> 2) & 0x33333333);
+        a = (a + (a >> 4)) & 0x0f0f0f0f;
+
+        return (a * 0x01010101) >> 24;
+    }
+
+    // Eight pixels at a time, the masks are a running xor of the toggles
+    vplUint evenOddCoverageAVX2(vplUint32* toggles,vplUint32* mask,
+                                vplUint32 fullCoverage,
+                                vplUint32* coverage,vplUint count)
+    {
+        const __m256i full = _mm256_set1_epi32(static_cast<int>(fullCoverage));
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i previous = _mm256_setr_epi32(0,0,1,2,3,4,5,6);
+
+        vplUint32 current = *mask;
+        vplUint i = 0;
+
+        while(i + 8 <= count)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(toggles + i));
+
+            // Prefix xor within the 128 bit halves, then carry the low
+            // half over to the high half
+            x = _mm256_xor_si256(x,_mm256_slli_si256(x,4));
+            x = _mm256_xor_si256(x,_mm256_slli_si256(x,8));
+            x = _mm256_xor_si256(x,_mm256_shuffle_epi32(_mm256_permute2x128_si256(x,x,0x08),0xff));
+
+            // Masks of the pixels after and at i to i + 7
+            __m256i next = _mm256_xor_si256(x,_mm256_set1_epi32(static_cast<int>(current)));
+            __m256i masks = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(next,previous),
+                                               _mm256_set1_epi32(static_cast<int>(current)),1);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(coverage + i),popcount(masks));
+
+            __m256i done = _mm256_or_si256(_mm256_cmpeq_epi32(next,zero),
+                                           _mm256_cmpeq_epi32(next,full));
+            int stop = _mm256_movemask_ps(_mm256_castsi256_ps(done));
+
+            vplUint32 nextMasks[8];
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(nextMasks),next);
+
+            if(stop)
+            {
+                vplUint last = 0;
+
+                while(!(stop & (1 << last)))
+                    last++;
+
+                for(vplUint j = 0; j <= last; j++)
+                    toggles[i + j] = 0;
+
+                *mask = nextMasks[last];
+
+                return i + last + 1;
+            }
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(toggles + i),zero);
+
+            current = nextMasks[7];
+            i += 8;
+        }
+
+        while(i < count)
+        {
+            coverage[i] = popcount(current);
+            current ^= toggles[i];
+            toggles[i++] = 0;
+
+            if(current == 0 || current == fullCoverage)
+                break;
+        }
+
+        *mask = current;
+
+        return i;
+    }
+
+    // Color table index of eight rounded positions, one struct per
+    // spread in Gradient::Spread order
+    struct PadIndexAVX2
+    {
+        static inline __m256i getIndex(__m256i index,vplUint tableSize)
+        {
+            index = _mm256_max_epi32(index,_mm256_setzero_si256());
+
+            return _mm256_min_epi32(index,_mm256_set1_epi32(static_cast<int>(tableSize) - 1));
+        }
+    };
+
+    struct ReflectIndexAVX2
+    {
+        static inline __m256i getIndex(__m256i index,vplUint tableSize)
+        {
+            __m256i size = _mm256_set1_epi32(static_cast<int>(tableSize));
+            __m256i mirror = _mm256_cmpeq_epi32(_mm256_and_si256(index,size),size);
+
+            return _mm256_and_si256(_mm256_xor_si256(index,mirror),
+                                    _mm256_set1_epi32(static_cast<int>(tableSize) - 1));
+        }
+    };
+
+    struct RepeatIndexAVX2
+    {
+        static inline __m256i getIndex(__m256i index,vplUint tableSize)
+        {
+            return _mm256_and_si256(index,
+                                    _mm256_set1_epi32(static_cast<int>(tableSize) - 1));
+        }
+    };
+
+    // Eight pixels at a time with a gather from the color table
+    template<class I> vplUint linearGradientAVX2(vplUint32* dest,const vplUint32* colorTable,
+                                                 vplUint tableSize,vplUint32 position,
+                                                 vplUint32 increment,vplUint count)
+    {
+        __m256i positions = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(position)),
+                                             _mm256_mullo_epi32(_mm256_setr_epi32(0,1,2,3,4,5,6,7),
+                                                                _mm256_set1_epi32(static_cast<int>(increment))));
+        __m256i step = _mm256_set1_epi32(static_cast<int>(increment * 8));
+        const int* table = reinterpret_cast<const int*>(colorTable);
+        vplUint end = count - count % 8;
+
+        for(vplUint i = 0; i < end; i += 8)
+        {
+            __m256i index = I::getIndex(_mm256_srai_epi32(positions,16),tableSize);
+            __m256i colors = _mm256_i32gather_epi32(table,index,4);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),colors);
+
+            positions = _mm256_add_epi32(positions,step);
+        }
+
+        return end;
+    }
+
+    // Radial gradient, the same float operations as the scalar code
+    template<class I,bool centered> vplUint radialGradientAVX2(vplUint32* dest,
+                                                               const vplUint32* colorTable,
+                                                               vplUint tableSize,
+                                                               const vpl::RadialGradientSpan& span,
+                                                               vplUint count)
+    {
+        __m256 offset = _mm256_setr_ps(0.0f,1.0f,2.0f,3.0f,4.0f,5.0f,6.0f,7.0f);
+        __m256 step = _mm256_set1_ps(8.0f);
+        __m256 x0 = _mm256_set1_ps(span.x_);
+        __m256 a = _mm256_set1_ps(span.a_);
+        __m256 bx = _mm256_set1_ps(span.bx_);
+        __m256 by = _mm256_set1_ps(span.by_);
+        __m256 k = _mm256_set1_ps(span.k_);
+        __m256 scale = _mm256_set1_ps(span.scale_);
+        __m256 half = _mm256_set1_ps(0.5f);
+        __m256 maxPosition = _mm256_set1_ps(vpl::cMaxGradientPosition);
+        const int* table = reinterpret_cast<const int*>(colorTable);
+        vplUint end = count - count % 8;
+
+        for(vplUint i = 0; i < end; i += 8)
+        {
+            __m256 x = _mm256_add_ps(x0,offset);
+            __m256 d = _mm256_mul_ps(k,_mm256_add_ps(_mm256_mul_ps(x,x),a));
+            __m256 pos;
+
+            if(centered)
+                pos = _mm256_add_ps(_mm256_mul_ps(_mm256_sqrt_ps(d),scale),half);
+            else
+            {
+                __m256 b = _mm256_add_ps(_mm256_mul_ps(bx,x),by);
+                __m256 root = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(b,b),d));
+
+                pos = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(b,root),scale),half);
+            }
+
+            pos = _mm256_min_ps(pos,maxPosition);
+
+            __m256i index = I::getIndex(_mm256_cvttps_epi32(pos),tableSize);
+            __m256i colors = _mm256_i32gather_epi32(table,index,4);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),colors);
+
+            offset = _mm256_add_ps(offset,step);
+        }
+
+        return end;
+    }
+
+    template<class I> vplUint radialGradientAVX2(vplUint32* dest,const vplUint32* colorTable,
+                                                 vplUint tableSize,
+                                                 const vpl::RadialGradientSpan& span,
+                                                 vplUint count)
+    {
+        if(span.centered_)
+            return radialGradientAVX2<I,true>(dest,colorTable,tableSize,span,count);
+        else
+            return radialGradientAVX2<I,false>(dest,colorTable,tableSize,span,count);
+    }
+}
+
+namespace vpl
+{
+    void setBlendKernelsAVX2(BlendKernels& kernels)
+    {
+        setBlendKernels<AVX2Vector>(kernels);
+
+        kernels.evenOddCoverage_ = &evenOddCoverageAVX2;
+
+        kernels.linearGradient_[0] = &linearGradientAVX2<PadIndexAVX2>;
+        kernels.linearGradient_[1] = &linearGradientAVX2<ReflectIndexAVX2>;
+        kernels.linearGradient_[2] = &linearGradientAVX2<RepeatIndexAVX2>;
+
+        kernels.radialGradient_[0] = &radialGradientAVX2<PadIndexAVX2>;
+        kernels.radialGradient_[1] = &radialGradientAVX2<ReflectIndexAVX2>;
+        kernels.radialGradient_[2] = &radialGradientAVX2<RepeatIndexAVX2>;
+    }
+}
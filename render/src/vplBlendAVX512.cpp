@@ -0,0 +1,285 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <immintrin.h>
+#include "vplBlendOps.h"
+
+// Compiled with AVX-512 enabled, only called when the processor has it
+namespace
+{
+    // AVX-512, sixteen pixels at a time
+    struct AVX512Vector
+    {
+        typedef __m512i Type;
+
+        static const vplUint cWidth = 16;
+
+        static inline Type load(const vplUint32* p)
+        {
+            return _mm512_loadu_si512(p);
+        }
+
+        static inline void store(vplUint32* p,Type a)
+        {
+            _mm512_storeu_si512(p,a);
+        }
+
+        static inline Type set1(vplUint32 a)
+        {
+            return _mm512_set1_epi32(static_cast<int>(a));
+        }
+
+        static inline Type add(Type a,Type b)     {return _mm512_add_epi32(a,b);}
+        static inline Type andOp(Type a,Type b)   {return _mm512_and_si512(a,b);}
+        static inline Type orOp(Type a,Type b)    {return _mm512_or_si512(a,b);}
+        static inline Type xorOp(Type a,Type b)   {return _mm512_xor_si512(a,b);}
+        static inline Type mullo16(Type a,Type b) {return _mm512_mullo_epi16(a,b);}
+        static inline Type srli(Type a,int n)     {return _mm512_srli_epi32(a,n);}
+        static inline Type slli(Type a,int n)     {return _mm512_slli_epi32(a,n);}
+    };
+
+    // Bits set in each lane
+    inline __m512i popcount(__m512i a)
+    {
+        const __m512i table = _mm512_broadcast_i32x4(_mm_setr_epi8(0,1,1,2,1,2,2,3,
+                                                                   1,2,2,3,2,3,3,4));
+        const __m512i low = _mm512_set1_epi8(0x0f);
+
+        __m512i bytes = _mm512_add_epi8(_mm512_shuffle_epi8(table,_mm512_and_si512(a,low)),
+                                        _mm512_shuffle_epi8(table,_mm512_and_si512(_mm512_srli_epi16(a,4),low)));
+
+        return _mm512_madd_epi16(_mm512_maddubs_epi16(bytes,_mm512_set1_epi8(1)),
+                                 _mm512_set1_epi16(1));
+    }
+
+    inline vplUint32 popcount(vplUint32 a)
+    {
+        a = a - ((a >> 1) & 0x55555555);
+        a = (a & 0x33333333) + ((a >> 2) & 0x33333333);
+        a = (a + (a >> 4)) & 0x0f0f0f0f;
+
+        return (a * 0x01010101) >> 24;
+    }
+
+    // Sixteen pixels at a time, the masks are a running xor of the toggles
+    vplUint evenOddCoverageAVX512(vplUint32* toggles,vplUint32* mask,
+                                  vplUint32 fullCoverage,
+                                  vplUint32* coverage,vplUint count)
+    {
+        const __m512i full = _mm512_set1_epi32(static_cast<int>(fullCoverage));
+        const __m512i zero = _mm512_setzero_si512();
+
+        vplUint32 current = *mask;
+        vplUint i = 0;
+
+        while(i + 16 <= count)
+        {
+            __m512i x = _mm512_loadu_si512(toggles + i);
+
+            // Prefix xor, lanes move up with zeros shifted in
+            x = _mm512_xor_si512(x,_mm512_alignr_epi32(x,zero,15));
+            x = _mm512_xor_si512(x,_mm512_alignr_epi32(x,zero,14));
+            x = _mm512_xor_si512(x,_mm512_alignr_epi32(x,zero,12));
+            x = _mm512_xor_si512(x,_mm512_alignr_epi32(x,zero,8));
+
+            // Masks of the pixels after and at i to i + 15
+            __m512i start = _mm512_set1_epi32(static_cast<int>(current));
+            __m512i next = _mm512_xor_si512(x,start);
+            __m512i masks = _mm512_alignr_epi32(next,start,15);
+
+            _mm512_storeu_si512(coverage + i,popcount(masks));
+
+            __mmask16 stop = _mm512_cmpeq_epi32_mask(next,zero) |
+                             _mm512_cmpeq_epi32_mask(next,full);
+
+            vplUint32 nextMasks[16];
+            _mm512_storeu_si512(nextMasks,next);
+
+            if(stop)
+            {
+                vplUint last = 0;
+
+                while(!(stop & (1 << last)))
+                    last++;
+
+                for(vplUint j = 0; j <= last; j++)
+                    toggles[i + j] = 0;
+
+                *mask = nextMasks[last];
+
+                return i + last + 1;
+            }
+
+            _mm512_storeu_si512(toggles + i,zero);
+
+            current = nextMasks[15];
+            i += 16;
+        }
+
+        while(i < count)
+        {
+            coverage[i] = popcount(current);
+            current ^= toggles[i];
+            toggles[i++] = 0;
+
+            if(current == 0 || current == fullCoverage)
+                break;
+        }
+
+        *mask = current;
+
+        return i;
+    }
+
+    // Color table index of sixteen rounded positions, one struct per
+    // spread in Gradient::Spread order
+    struct PadIndexAVX512
+    {
+        static inline __m512i getIndex(__m512i index,vplUint tableSize)
+        {
+            index = _mm512_max_epi32(index,_mm512_setzero_si512());
+
+            return _mm512_min_epi32(index,_mm512_set1_epi32(static_cast<int>(tableSize) - 1));
+        }
+    };
+
+    struct ReflectIndexAVX512
+    {
+        static inline __m512i getIndex(__m512i index,vplUint tableSize)
+        {
+            __m512i size = _mm512_set1_epi32(static_cast<int>(tableSize));
+            __m512i mirror = _mm512_maskz_mov_epi32(_mm512_test_epi32_mask(index,size),
+                                                    _mm512_set1_epi32(-1));
+
+            return _mm512_and_si512(_mm512_xor_si512(index,mirror),
+                                    _mm512_set1_epi32(static_cast<int>(tableSize) - 1));
+        }
+    };
+
+    struct RepeatIndexAVX512
+    {
+        static inline __m512i getIndex(__m512i index,vplUint tableSize)
+        {
+            return _mm512_and_si512(index,
+                                    _mm512_set1_epi32(static_cast<int>(tableSize) - 1));
+        }
+    };
+
+    // Sixteen pixels at a time with a gather from the color table
+    template<class I> vplUint linearGradientAVX512(vplUint32* dest,const vplUint32* colorTable,
+                                                   vplUint tableSize,vplUint32 position,
+                                                   vplUint32 increment,vplUint count)
+    {
+        __m512i positions = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(position)),
+                                             _mm512_mullo_epi32(_mm512_setr_epi32(0,1,2,3,4,5,6,7,
+                                                                                  8,9,10,11,12,13,14,15),
+                                                                _mm512_set1_epi32(static_cast<int>(increment))));
+        __m512i step = _mm512_set1_epi32(static_cast<int>(increment * 16));
+        vplUint end = count - count % 16;
+
+        for(vplUint i = 0; i < end; i += 16)
+        {
+            __m512i index = I::getIndex(_mm512_srai_epi32(positions,16),tableSize);
+            __m512i colors = _mm512_i32gather_epi32(index,colorTable,4);
+
+            _mm512_storeu_si512(dest + i,colors);
+
+            positions = _mm512_add_epi32(positions,step);
+        }
+
+        return end;
+    }
+
+    // Radial gradient, the same float operations as the scalar code
+    template<class I,bool centered> vplUint radialGradientAVX512(vplUint32* dest,
+                                                                 const vplUint32* colorTable,
+                                                                 vplUint tableSize,
+                                                                 const vpl::RadialGradientSpan& span,
+                                                                 vplUint count)
+    {
+        __m512 offset = _mm512_setr_ps(0.0f,1.0f,2.0f,3.0f,4.0f,5.0f,6.0f,7.0f,
+                                       8.0f,9.0f,10.0f,11.0f,12.0f,13.0f,14.0f,15.0f);
+        __m512 step = _mm512_set1_ps(16.0f);
+        __m512 x0 = _mm512_set1_ps(span.x_);
+        __m512 a = _mm512_set1_ps(span.a_);
+        __m512 bx = _mm512_set1_ps(span.bx_);
+        __m512 by = _mm512_set1_ps(span.by_);
+        __m512 k = _mm512_set1_ps(span.k_);
+        __m512 scale = _mm512_set1_ps(span.scale_);
+        __m512 half = _mm512_set1_ps(0.5f);
+        __m512 maxPosition = _mm512_set1_ps(vpl::cMaxGradientPosition);
+        vplUint end = count - count % 16;
+
+        for(vplUint i = 0; i < end; i += 16)
+        {
+            __m512 x = _mm512_add_ps(x0,offset);
+            __m512 d = _mm512_mul_ps(k,_mm512_add_ps(_mm512_mul_ps(x,x),a));
+            __m512 pos;
+
+            if(centered)
+                pos = _mm512_add_ps(_mm512_mul_ps(_mm512_sqrt_ps(d),scale),half);
+            else
+            {
+                __m512 b = _mm512_add_ps(_mm512_mul_ps(bx,x),by);
+                __m512 root = _mm512_sqrt_ps(_mm512_add_ps(_mm512_mul_ps(b,b),d));
+
+                pos = _mm512_add_ps(_mm512_mul_ps(_mm512_add_ps(b,root),scale),half);
+            }
+
+            pos = _mm512_min_ps(pos,maxPosition);
+
+            __m512i index = I::getIndex(_mm512_cvttps_epi32(pos),tableSize);
+            __m512i colors = _mm512_i32gather_epi32(index,colorTable,4);
+
+            _mm512_storeu_si512(dest + i,colors);
+
+            offset = _mm512_add_ps(offset,step);
+        }
+
+        return end;
+    }
+
+    template<class I> vplUint radialGradientAVX512(vplUint32* dest,const vplUint32* colorTable,
+                                                   vplUint tableSize,
+                                                   const vpl::RadialGradientSpan& span,
+                                                   vplUint count)
+    {
+        if(span.centered_)
+            return radialGradientAVX512<I,true>(dest,colorTable,tableSize,span,count);
+        else
+            return radialGradientAVX512<I,false>(dest,colorTable,tableSize,span,count);
+    }
+}
+
+namespace vpl
+{
+    void setBlendKernelsAVX512(BlendKernels& kernels)
+    {
+        setBlendKernels<AVX512Vector>(kernels);
+
+        kernels.evenOddCoverage_ = &evenOddCoverageAVX512;
+
+        kernels.linearGradient_[0] = &linearGradientAVX512<PadIndexAVX512>;
+        kernels.linearGradient_[1] = &linearGradientAVX512<ReflectIndexAVX512>;
+        kernels.linearGradient_[2] = &linearGradientAVX512<RepeatIndexAVX512>;
+
+        kernels.radialGradient_[0] = &radialGradientAVX512<PadIndexAVX512>;
+        kernels.radialGradient_[1] = &radialGradientAVX512<ReflectIndexAVX512>;
+        kernels.radialGradient_[2] = &radialGradientAVX512<RepeatIndexAVX512>;
+    }
+}
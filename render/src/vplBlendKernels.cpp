@@ -0,0 +1,123 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "vplBlendKernels.h"
+#include "vplCpu.h"
+#include "vplPixelCoverage.h"
+
+namespace vpl
+{
+    // Reference path, leave everything to the scalar code
+    static vplUint blendColorScalar(vplUint32*,vplUint32,vplUint)
+    {
+        return 0;
+    }
+
+    static vplUint blendSpanScalar(vplUint32*,const vplUint32*,vplUint)
+    {
+        return 0;
+    }
+
+    static vplUint blendScaledScalar(vplUint32*,const vplUint32*,vplUchar,vplUint)
+    {
+        return 0;
+    }
+
+    static vplUint linearGradientScalar(vplUint32*,const vplUint32*,vplUint,
+                                        vplUint32,vplUint32,vplUint)
+    {
+        return 0;
+    }
+
+    static vplUint radialGradientScalar(vplUint32*,const vplUint32*,vplUint,
+                                        const RadialGradientSpan&,vplUint)
+    {
+        return 0;
+    }
+
+    static vplUint evenOddCoverageScalar(vplUint32* toggles,vplUint32* mask,
+                                         vplUint32 fullCoverage,
+                                         vplUint32* coverage,vplUint count)
+    {
+        vplUint32 current = *mask;
+        vplUint i = 0;
+
+        while(i < count)
+        {
+            coverage[i] = getPixelCoverage(current);
+            current ^= toggles[i];
+            toggles[i++] = 0;
+
+            if(current == 0 || current == fullCoverage)
+                break;
+        }
+
+        *mask = current;
+
+        return i;
+    }
+
+    static void setBlendKernelsScalar(BlendKernels& kernels)
+    {
+        for(int i = 0; i < cNumBlendModes; i++)
+        {
+            kernels.color_[i] = &blendColorScalar;
+            kernels.span_[i] = &blendSpanScalar;
+        }
+
+        kernels.srcOverScaled_ = &blendScaledScalar;
+        kernels.evenOddCoverage_ = &evenOddCoverageScalar;
+
+        for(int i = 0; i < cNumGradientSpreads; i++)
+        {
+            kernels.linearGradient_[i] = &linearGradientScalar;
+            kernels.radialGradient_[i] = &radialGradientScalar;
+        }
+    }
+
+    static BlendKernels chooseBlendKernels()
+    {
+        BlendKernels kernels;
+
+        setBlendKernelsScalar(kernels);
+
+#ifdef HAVE_X86_KERNELS_
+        vplUint32 features = getCpuFeatures();
+
+        if(features & cCpuPopcnt)
+            setBlendKernelsPopcnt(kernels);
+
+        if(features & cCpuAVX512)
+            setBlendKernelsAVX512(kernels);
+        else if(features & cCpuAVX2)
+            setBlendKernelsAVX2(kernels);
+        else if(features & cCpuSSE2)
+            setBlendKernelsSSE2(kernels);
+#endif
+
+        return kernels;
+    }
+
+    // Chosen once when the library is loaded
+    static const BlendKernels blendKernels = chooseBlendKernels();
+
+    const BlendKernels& getBlendKernels()
+    {
+        return blendKernels;
+    }
+}
@@ -0,0 +1,108 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VPL_BLEND_KERNELS_H_INCLUDED_
+#define VPL_BLEND_KERNELS_H_INCLUDED_
+
+#include "vplConfig.h"
+#include "vplBlendMode.h"
+
+namespace vpl
+{
+    static const int cNumBlendModes = cSrcXorDest + 1;
+
+    // Pad, reflect and repeat, indexed as Gradient::Spread
+    static const int cNumGradientSpreads = 3;
+
+    // Vectorized span blends. A kernel blends as many whole vectors as
+    // fit in count and returns the number of pixels it blended, the rest
+    // is left to the scalar code in the blenders.
+
+    // Blend a color into a span
+    typedef vplUint (*ColorBlendKernel)(vplUint32* dest,vplUint32 color,
+                                        vplUint count);
+
+    // Blend a span into a span
+    typedef vplUint (*SpanBlendKernel)(vplUint32* dest,const vplUint32* src,
+                                       vplUint count);
+
+    // dest = src + dest * alpha
+    typedef vplUint (*ScaledBlendKernel)(vplUint32* dest,const vplUint32* src,
+                                         vplUchar alpha,vplUint count);
+
+    // Coverage of the partially covered pixels that follow each other in
+    // an even-odd mask buffer. mask is the mask of the first pixel and
+    // toggles[i] is xored in to get the mask of the pixel after pixel i.
+    // Stops after the pixel whose next mask is empty or full, or after
+    // count pixels, and returns the number of pixels. The toggles used are
+    // cleared and mask is left with the mask of the next pixel.
+    typedef vplUint (*EvenOddCoverageKernel)(vplUint32* toggles,vplUint32* mask,
+                                             vplUint32 fullCoverage,
+                                             vplUint32* coverage,vplUint count);
+
+    // Linear gradient span looked up in a color table with a power of two
+    // size. position and increment are table indices in 16.16 fixed point,
+    // returns the number of pixels done like the span blends.
+    typedef vplUint (*GradientSpanKernel)(vplUint32* dest,const vplUint32* colorTable,
+                                          vplUint tableSize,vplUint32 position,
+                                          vplUint32 increment,vplUint count);
+
+    // Radial gradient span. For the pixel i of the span
+    // x = x_ + i, b = bx_ * x + by_, D = b * b + k_ * (x * x + a_)
+    // and the color table position is (b + sqrt(D)) * scale_. b is zero
+    // when the focal point is at the center.
+    struct RadialGradientSpan
+    {
+        float x_;
+        float a_;
+        float bx_;
+        float by_;
+        float k_;
+        float scale_;
+        bool centered_;
+    };
+
+    typedef vplUint (*RadialGradientKernel)(vplUint32* dest,const vplUint32* colorTable,
+                                            vplUint tableSize,
+                                            const RadialGradientSpan& span,
+                                            vplUint count);
+
+    // Largest color table position, keeps the conversion to int in range
+    static const float cMaxGradientPosition = 1073741824.0f;
+
+    struct BlendKernels
+    {
+        ColorBlendKernel color_[cNumBlendModes];
+        SpanBlendKernel span_[cNumBlendModes];
+        ScaledBlendKernel srcOverScaled_;
+        EvenOddCoverageKernel evenOddCoverage_;
+        GradientSpanKernel linearGradient_[cNumGradientSpreads];
+        RadialGradientKernel radialGradient_[cNumGradientSpreads];
+    };
+
+    // Kernels for the instruction sets of this processor, chosen at startup
+    const BlendKernels& getBlendKernels();
+
+#ifdef HAVE_X86_KERNELS_
+    void setBlendKernelsPopcnt(BlendKernels& kernels);
+    void setBlendKernelsSSE2(BlendKernels& kernels);
+    void setBlendKernelsAVX2(BlendKernels& kernels);
+    void setBlendKernelsAVX512(BlendKernels& kernels);
+#endif
+}
+#endif
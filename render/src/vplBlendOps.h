@@ -0,0 +1,243 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VPL_BLEND_OPS_H_INCLUDED_
+#define VPL_BLEND_OPS_H_INCLUDED_
+
+#include "vplBlendKernels.h"
+
+// Porter Duff span blends written once for any vector width. V wraps the
+// instructions of an instruction set, see vplBlendSSE2.cpp. Every lane
+// holds one pixel and the arithmetic is the same as multiplyPixel and
+// interpolatePixel, so the result is bit exact with the scalar code.
+// Only include this in the instruction set specific source files.
+namespace vpl
+{
+    template<class V> struct PixelOps
+    {
+        typedef typename V::Type Type;
+
+        // Alpha in both 16 bit halves of the lanes
+        static inline Type alpha(Type pixel)
+        {
+            Type a = V::srli(pixel,24);
+
+            return V::orOp(a,V::slli(a,16));
+        }
+
+        static inline Type inverseAlpha(Type pixel)
+        {
+            return alpha(V::xorOp(pixel,V::set1(0xffffffff)));
+        }
+
+        static inline Type multiply(Type pixel,Type alpha)
+        {
+            Type mask = V::set1(0xff00ff);
+            Type round = V::set1(0x800080);
+
+            Type t = V::mullo16(V::andOp(pixel,mask),alpha);
+            t = V::add(V::add(t,V::andOp(V::srli(t,8),mask)),round);
+            t = V::andOp(V::srli(t,8),mask);
+
+            Type u = V::mullo16(V::andOp(V::srli(pixel,8),mask),alpha);
+            u = V::add(V::add(u,V::andOp(V::srli(u,8),mask)),round);
+            u = V::andOp(u,V::set1(0xff00ff00));
+
+            return V::orOp(t,u);
+        }
+
+        static inline Type interpolate(Type color1,Type alpha1,
+                                       Type color2,Type alpha2)
+        {
+            Type mask = V::set1(0xff00ff);
+            Type round = V::set1(0x800080);
+
+            Type t = V::add(V::mullo16(V::andOp(color1,mask),alpha1),
+                            V::mullo16(V::andOp(color2,mask),alpha2));
+            t = V::add(V::add(t,V::andOp(V::srli(t,8),mask)),round);
+            t = V::andOp(V::srli(t,8),mask);
+
+            Type u = V::add(V::mullo16(V::andOp(V::srli(color1,8),mask),alpha1),
+                            V::mullo16(V::andOp(V::srli(color2,8),mask),alpha2));
+            u = V::add(V::add(u,V::andOp(V::srli(u,8),mask)),round);
+            u = V::andOp(u,V::set1(0xff00ff00));
+
+            return V::orOp(t,u);
+        }
+    };
+
+    // One operation per blend mode, src and dest are premultiplied
+    template<class V> struct SrcOverDestOp
+    {
+        typedef typename V::Type Type;
+
+        static inline Type blend(Type src,Type dest)
+        {
+            return V::add(src,PixelOps<V>::multiply(dest,PixelOps<V>::inverseAlpha(src)));
+        }
+    };
+
+    template<class V> struct DestOverSrcOp
+    {
+        typedef typename V::Type Type;
+
+        static inline Type blend(Type src,Type dest)
+        {
+            return V::add(dest,PixelOps<V>::multiply(src,PixelOps<V>::inverseAlpha(dest)));
+        }
+    };
+
+    template<class V> struct SrcInDestOp
+    {
+        typedef typename V::Type Type;
+
+        static inline Type blend(Type src,Type dest)
+        {
+            return PixelOps<V>::multiply(src,PixelOps<V>::alpha(dest));
+        }
+    };
+
+    template<class V> struct DestInSrcOp
+    {
+        typedef typename V::Type Type;
+
+        static inline Type blend(Type src,Type dest)
+        {
+            return PixelOps<V>::multiply(dest,PixelOps<V>::alpha(src));
+        }
+    };
+
+    template<class V> struct SrcOutDestOp
+    {
+        typedef typename V::Type Type;
+
+        static inline Type blend(Type src,Type dest)
+        {
+            return PixelOps<V>::multiply(src,PixelOps<V>::inverseAlpha(dest));
+        }
+    };
+
+    template<class V> struct DestOutSrcOp
+    {
+        typedef typename V::Type Type;
+
+        static inline Type blend(Type src,Type dest)
+        {
+            return PixelOps<V>::multiply(dest,PixelOps<V>::inverseAlpha(src));
+        }
+    };
+
+    template<class V> struct SrcAtopDestOp
+    {
+        typedef typename V::Type Type;
+
+        static inline Type blend(Type src,Type dest)
+        {
+            return PixelOps<V>::interpolate(src,PixelOps<V>::alpha(dest),
+                                            dest,PixelOps<V>::inverseAlpha(src));
+        }
+    };
+
+    template<class V> struct DestAtopSrcOp
+    {
+        typedef typename V::Type Type;
+
+        static inline Type blend(Type src,Type dest)
+        {
+            return PixelOps<V>::interpolate(dest,PixelOps<V>::alpha(src),
+                                            src,PixelOps<V>::inverseAlpha(dest));
+        }
+    };
+
+    template<class V> struct SrcXorDestOp
+    {
+        typedef typename V::Type Type;
+
+        static inline Type blend(Type src,Type dest)
+        {
+            return PixelOps<V>::interpolate(src,PixelOps<V>::inverseAlpha(dest),
+                                            dest,PixelOps<V>::inverseAlpha(src));
+        }
+    };
+
+    // Kernels
+    template<class V,class Op> vplUint blendColor(vplUint32* dest,vplUint32 color,
+                                                  vplUint count)
+    {
+        typename V::Type src = V::set1(color);
+        vplUint end = count - count % V::cWidth;
+
+        for(vplUint i = 0; i < end; i += V::cWidth)
+            V::store(dest + i,Op::blend(src,V::load(dest + i)));
+
+        return end;
+    }
+
+    template<class V,class Op> vplUint blendSpan(vplUint32* dest,const vplUint32* src,
+                                                 vplUint count)
+    {
+        vplUint end = count - count % V::cWidth;
+
+        for(vplUint i = 0; i < end; i += V::cWidth)
+            V::store(dest + i,Op::blend(V::load(src + i),V::load(dest + i)));
+
+        return end;
+    }
+
+    template<class V> vplUint blendScaled(vplUint32* dest,const vplUint32* src,
+                                          vplUchar alpha,vplUint count)
+    {
+        typename V::Type scale = V::set1(alpha | (alpha << 16));
+        vplUint end = count - count % V::cWidth;
+
+        for(vplUint i = 0; i < end; i += V::cWidth)
+        {
+            V::store(dest + i,V::add(V::load(src + i),
+                                     PixelOps<V>::multiply(V::load(dest + i),scale)));
+        }
+
+        return end;
+    }
+
+    // Fill in the kernel table
+    template<class V> void setBlendKernels(BlendKernels& kernels)
+    {
+        kernels.color_[cSrcOverDest] = &blendColor<V,SrcOverDestOp<V> >;
+        kernels.color_[cDestOverSrc] = &blendColor<V,DestOverSrcOp<V> >;
+        kernels.color_[cSrcInDest]   = &blendColor<V,SrcInDestOp<V> >;
+        kernels.color_[cDestInSrc]   = &blendColor<V,DestInSrcOp<V> >;
+        kernels.color_[cSrcOutDest]  = &blendColor<V,SrcOutDestOp<V> >;
+        kernels.color_[cDestOutSrc]  = &blendColor<V,DestOutSrcOp<V> >;
+        kernels.color_[cSrcAtopDest] = &blendColor<V,SrcAtopDestOp<V> >;
+        kernels.color_[cDestAtopSrc] = &blendColor<V,DestAtopSrcOp<V> >;
+        kernels.color_[cSrcXorDest]  = &blendColor<V,SrcXorDestOp<V> >;
+
+        kernels.span_[cSrcOverDest] = &blendSpan<V,SrcOverDestOp<V> >;
+        kernels.span_[cDestOverSrc] = &blendSpan<V,DestOverSrcOp<V> >;
+        kernels.span_[cSrcInDest]   = &blendSpan<V,SrcInDestOp<V> >;
+        kernels.span_[cDestInSrc]   = &blendSpan<V,DestInSrcOp<V> >;
+        kernels.span_[cSrcOutDest]  = &blendSpan<V,SrcOutDestOp<V> >;
+        kernels.span_[cDestOutSrc]  = &blendSpan<V,DestOutSrcOp<V> >;
+        kernels.span_[cSrcAtopDest] = &blendSpan<V,SrcAtopDestOp<V> >;
+        kernels.span_[cDestAtopSrc] = &blendSpan<V,DestAtopSrcOp<V> >;
+        kernels.span_[cSrcXorDest]  = &blendSpan<V,SrcXorDestOp<V> >;
+
+        kernels.srcOverScaled_ = &blendScaled<V>;
+    }
+}
+#endif
@@ -0,0 +1,62 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <emmintrin.h>
+#include "vplBlendOps.h"
+
+namespace
+{
+    // SSE2, four pixels at a time
+    struct SSE2Vector
+    {
+        typedef __m128i Type;
+
+        static const vplUint cWidth = 4;
+
+        static inline Type load(const vplUint32* p)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        }
+
+        static inline void store(vplUint32* p,Type a)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p),a);
+        }
+
+        static inline Type set1(vplUint32 a)
+        {
+            return _mm_set1_epi32(static_cast<int>(a));
+        }
+
+        static inline Type add(Type a,Type b)     {return _mm_add_epi32(a,b);}
+        static inline Type andOp(Type a,Type b)   {return _mm_and_si128(a,b);}
+        static inline Type orOp(Type a,Type b)    {return _mm_or_si128(a,b);}
+        static inline Type xorOp(Type a,Type b)   {return _mm_xor_si128(a,b);}
+        static inline Type mullo16(Type a,Type b) {return _mm_mullo_epi16(a,b);}
+        static inline Type srli(Type a,int n)     {return _mm_srli_epi32(a,n);}
+        static inline Type slli(Type a,int n)     {return _mm_slli_epi32(a,n);}
+    };
+}
+
+namespace vpl
+{
+    void setBlendKernelsSSE2(BlendKernels& kernels)
+    {
+        setBlendKernels<SSE2Vector>(kernels);
+    }
+}
@@ -0,0 +1,208 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "vplColorTableCache.h"
+
+namespace vpl
+{
+    // FNV-1a over the table size, offsets and colors
+    static vplUint32 hashStops(const Gradient::Stop* stops,vplUint stopCount,
+                               int size)
+    {
+        vplUint32 hash = (2166136261u ^ static_cast<vplUint32>(size)) * 16777619u;
+
+        for(vplUint i = 0; i < stopCount; i++)
+        {
+            union
+            {
+                float f_;
+                vplUint32 u_;
+            }offset;
+
+            offset.f_ = stops[i].offset_;
+
+            hash = (hash ^ offset.u_) * 16777619u;
+            hash = (hash ^ stops[i].color_.getColorRGBA()) * 16777619u;
+        }
+
+        return hash;
+    }
+
+    static bool hasStops(const ColorTable* table,const Gradient::Stop* stops,
+                         vplUint stopCount,int size)
+    {
+        if(table->size_ != size || table->stops_.getItemCount() != stopCount)
+            return false;
+
+        for(vplUint i = 0; i < stopCount; i++)
+        {
+            const Gradient::Stop& stop = table->stops_[i];
+
+            if(stop.offset_ != stops[i].offset_ ||
+               stop.color_.getColorRGBA() != stops[i].color_.getColorRGBA())
+                return false;
+        }
+
+        return true;
+    }
+
+    ColorTableCache::ColorTableCache():newestUnused_(0),oldestUnused_(0),
+                                       unusedCount_(0)
+    {
+        for(vplUint i = 0; i < cNumBuckets; i++)
+            buckets_[i] = 0;
+    }
+
+    ColorTableCache::~ColorTableCache()
+    {
+        for(vplUint i = 0; i < cNumBuckets; i++)
+        {
+            ColorTable* table = buckets_[i];
+
+            while(table)
+            {
+                ColorTable* next = table->next_;
+
+                delete table;
+
+                table = next;
+            }
+        }
+    }
+
+    ColorTable* ColorTableCache::acquire(const Gradient::Stop* stops,
+                                         vplUint stopCount,int size)
+    {
+        MutexLocker locker(mutex_);
+
+        vplUint32 hash = hashStops(stops,stopCount,size);
+        ColorTable* table = find(hash,stops,stopCount,size);
+
+        if(table)
+        {
+            if(table->refCount_ == 0)
+                unlinkUnused(table);
+
+            ++table->refCount_;
+
+            return table;
+        }
+
+        table = new ColorTable(size);
+
+        for(vplUint i = 0; i < stopCount; i++)
+            table->stops_.add(stops[i]);
+
+        table->hash_ = hash;
+        table->refCount_ = 1;
+        table->newer_ = 0;
+        table->older_ = 0;
+        table->next_ = buckets_[hash % cNumBuckets];
+        buckets_[hash % cNumBuckets] = table;
+
+        generateGradientColorTable(table->colors_,size,stops,stopCount);
+
+        return table;
+    }
+
+    void ColorTableCache::release(ColorTable* table)
+    {
+        if(!table)
+            return;
+
+        MutexLocker locker(mutex_);
+
+        if(--table->refCount_ > 0)
+            return;
+
+        // Newest first
+        table->newer_ = 0;
+        table->older_ = newestUnused_;
+
+        if(newestUnused_)
+            newestUnused_->newer_ = table;
+        else
+            oldestUnused_ = table;
+
+        newestUnused_ = table;
+        ++unusedCount_;
+
+        // Drop the least recently used
+        if(unusedCount_ > cMaxUnusedTables)
+        {
+            ColorTable* oldest = oldestUnused_;
+
+            unlinkUnused(oldest);
+            destroy(oldest);
+        }
+    }
+
+    ColorTable* ColorTableCache::find(vplUint32 hash,const Gradient::Stop* stops,
+                                      vplUint stopCount,int size)
+    {
+        ColorTable* table = buckets_[hash % cNumBuckets];
+
+        while(table)
+        {
+            if(table->hash_ == hash && hasStops(table,stops,stopCount,size))
+                return table;
+
+            table = table->next_;
+        }
+
+        return 0;
+    }
+
+    void ColorTableCache::unlinkUnused(ColorTable* table)
+    {
+        if(table->newer_)
+            table->newer_->older_ = table->older_;
+        else
+            newestUnused_ = table->older_;
+
+        if(table->older_)
+            table->older_->newer_ = table->newer_;
+        else
+            oldestUnused_ = table->newer_;
+
+        table->newer_ = 0;
+        table->older_ = 0;
+
+        --unusedCount_;
+    }
+
+    void ColorTableCache::destroy(ColorTable* table)
+    {
+        ColorTable** link = &buckets_[table->hash_ % cNumBuckets];
+
+        while(*link != table)
+            link = &(*link)->next_;
+
+        *link = table->next_;
+
+        delete table;
+    }
+
+    // Shared by all gradients. Never destroyed, gradients with static
+    // storage may release their tables after this file is finalized.
+    static ColorTableCache* const colorTableCache = new ColorTableCache;
+
+    ColorTableCache& getColorTableCache()
+    {
+        return *colorTableCache;
+    }
+}
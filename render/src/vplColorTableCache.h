@@ -0,0 +1,94 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VPL_COLOR_TABLE_CACHE_H_INCLUDED_
+#define VPL_COLOR_TABLE_CACHE_H_INCLUDED_
+
+#include "vplConfig.h"
+#include "vplArray.h"
+#include "vplThread.h"
+#include "vplGradient.h"
+
+namespace vpl
+{
+    // Generated color table of a stop list
+    struct ColorTable
+    {
+        ColorTable(int size):colors_(new vplUint32[size]),size_(size){}
+        ~ColorTable()
+        {
+            delete [] colors_;
+        }
+
+        vplUint32* colors_;
+        int size_;
+        DynamicArray<Gradient::Stop> stops_;
+        vplUint32 hash_;
+        vplUint refCount_;
+        // Next table in the same hash bucket
+        ColorTable* next_;
+        // Unused tables in release order
+        ColorTable* newer_;
+        ColorTable* older_;
+    };
+
+    // Color tables shared by all gradients of the process. Gradients with
+    // the same stops get the same table. Tables no longer used by any
+    // gradient are kept until cMaxUnusedTables newer ones are released, so
+    // going back to an earlier stop list does not generate it again.
+    class ColorTableCache
+    {
+    public:
+
+        static const vplUint cNumBuckets = 256;
+        static const vplUint cMaxUnusedTables = 64;
+
+        ColorTableCache();
+        ~ColorTableCache();
+
+        // Table of size entries for the stops, generated if it is not in
+        // the cache. Every acquired table must be released.
+        ColorTable* acquire(const Gradient::Stop* stops,vplUint stopCount,
+                            int size);
+        void release(ColorTable* table);
+
+    private:
+
+        // Not copyable
+        ColorTableCache(const ColorTableCache&);
+        ColorTableCache& operator=(const ColorTableCache&);
+
+        ColorTable* find(vplUint32 hash,const Gradient::Stop* stops,
+                         vplUint stopCount,int size);
+        void unlinkUnused(ColorTable* table);
+        void destroy(ColorTable* table);
+
+        Mutex mutex_;
+        ColorTable* buckets_[cNumBuckets];
+        ColorTable* newestUnused_;
+        ColorTable* oldestUnused_;
+        vplUint unusedCount_;
+    };
+
+    ColorTableCache& getColorTableCache();
+
+    // Fill a color table from a stop list, defined in vplGradient.cpp
+    void generateGradientColorTable(vplUint32* colorTable,int size,
+                                    const Gradient::Stop* stops,
+                                    vplUint stopCount);
+}
+#endif
@@ -0,0 +1,564 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include "vplCommandBuffer.h"
+
+namespace vpl
+{
+    // First words of every buffer
+    static const vplUint32 cCommandBufferMagic = 0x434c5056;
+    static const vplUint32 cCommandBufferVersion = 1;
+    static const vplUint cHeaderSize = 2;
+
+    // Words of each part of a command
+    static const vplUint cPenSize = 7;
+    static const vplUint cBrushSize = 4;
+    static const vplUint cPathSize = 9;
+    static const vplUint cSegmentSize = 7;
+    static const vplUint cGradientSize = 9;
+
+    // What an add path command holds
+    static const vplUint32 cPenFlag = 1;
+    static const vplUint32 cBrushFlag = 2;
+
+    static inline float toFloat(vplUint32 word)
+    {
+        float value;
+
+        std::memcpy(&value,&word,sizeof(value));
+
+        return value;
+    }
+
+    static inline AffineMatrix toMatrix(const vplUint32* words)
+    {
+        AffineMatrix matrix;
+
+        matrix.setMatrix(toFloat(words[0]),toFloat(words[1]),toFloat(words[2]),
+                         toFloat(words[3]),toFloat(words[4]),toFloat(words[5]));
+
+        return matrix;
+    }
+
+    static inline bool isValidSegment(vplUint32 command)
+    {
+        return command == Path::cClosePath ||
+               (command >= Path::cMoveToAbs && command <= Path::cLargeClockwiseArcToRel);
+    }
+
+    static bool isValidPen(const vplUint32* words,vplUint numGradients)
+    {
+        return words[1] <= numGradients &&
+               words[4] <= Stroker::cSquareEnd &&
+               words[5] <= Stroker::cMiterJoin &&
+               words[6] <= cSrcXorDest;
+    }
+
+    static bool isValidBrush(const vplUint32* words,vplUint numGradients)
+    {
+        return words[1] <= numGradients &&
+               words[2] <= cSrcXorDest &&
+               words[3] <= Brush::cNonZero;
+    }
+
+    static Gradient* toGradient(vplUint32 index,DynamicArray<Gradient*>& gradients)
+    {
+        return index ? gradients[index - 1] : 0;
+    }
+
+    CommandBuffer::CommandBuffer():decodedSize_(cHeaderSize)
+    {
+        words_.add(cCommandBufferMagic);
+        words_.add(cCommandBufferVersion);
+    }
+
+    CommandBuffer::~CommandBuffer()
+    {
+        clear();
+    }
+
+    void CommandBuffer::clear()
+    {
+        for(vplUint i = 0; i < paths_.getItemCount(); i++)
+            delete paths_[i];
+
+        for(vplUint i = 0; i < gradients_.getItemCount(); i++)
+            delete gradients_[i];
+
+        paths_.clear();
+        gradients_.clear();
+        recordedGradients_.clear();
+        recordedPositions_.clear();
+
+        words_.resize(cHeaderSize);
+        decodedSize_ = cHeaderSize;
+    }
+
+    void CommandBuffer::addCommand(Command command,vplUint size)
+    {
+        words_.reserve(words_.getItemCount() + size + 2);
+
+        words_.add(command);
+        words_.add(size);
+    }
+
+    void CommandBuffer::addFloat(float value)
+    {
+        vplUint32 word;
+
+        std::memcpy(&word,&value,sizeof(word));
+
+        words_.add(word);
+    }
+
+    void CommandBuffer::addMatrix(const AffineMatrix& matrix)
+    {
+        const float* m = matrix.getMatrix();
+
+        for(vplUint i = 0; i < 6; i++)
+            addFloat(m[i]);
+    }
+
+    // Index of the gradient plus one. It is recorded the first time and
+    // again when it differs from the copy recorded last
+    vplUint CommandBuffer::addGradient(const Gradient* gradient)
+    {
+        if(!gradient)
+            return 0;
+
+        vplUint position = words_.getItemCount();
+        vplUint numStops = gradient->stops_.getItemCount();
+
+        addCommand(cAddGradientCommand,cGradientSize + 2*numStops);
+
+        words_.add(gradient->type_);
+        words_.add(gradient->spread_);
+        words_.add(gradient->lookup_);
+
+        if(gradient->type_ == Gradient::cLinear)
+        {
+            addFloat(gradient->data_.LinearGradientData.x_);
+            addFloat(gradient->data_.LinearGradientData.y_);
+            addFloat(gradient->data_.LinearGradientData.dirX_);
+            addFloat(gradient->data_.LinearGradientData.dirY_);
+            addFloat(0.0f);
+        }
+        else
+        {
+            addFloat(gradient->data_.RadialGradientData.cx_);
+            addFloat(gradient->data_.RadialGradientData.cy_);
+            addFloat(gradient->data_.RadialGradientData.fx_);
+            addFloat(gradient->data_.RadialGradientData.fy_);
+            addFloat(gradient->data_.RadialGradientData.radius_);
+        }
+
+        words_.add(numStops);
+
+        for(vplUint i = 0; i < numStops; i++)
+        {
+            addFloat(gradient->stops_[i].offset_);
+            words_.add(gradient->stops_[i].color_.getColorARGB());
+        }
+
+        // Drop the new copy if the last one is the same
+        for(vplUint i = recordedGradients_.getItemCount(); i > 0; i--)
+        {
+            if(recordedGradients_[i - 1] != gradient)
+                continue;
+
+            vplUint size = words_.getItemCount() - position;
+            const vplUint32* last = words_.getContents() + recordedPositions_[i - 1];
+
+            if(last[1] + 2 == size &&
+               std::memcmp(last,words_.getContents() + position,
+                           size*sizeof(vplUint32)) == 0)
+            {
+                words_.resize(position);
+
+                return i;
+            }
+
+            break;
+        }
+
+        recordedGradients_.add(gradient);
+        recordedPositions_.add(position);
+
+        return recordedGradients_.getItemCount();
+    }
+
+    void CommandBuffer::setClipRect(const Rect& rect)
+    {
+        addCommand(cSetClipRectCommand,4);
+
+        addFloat(rect.left_);
+        addFloat(rect.right_);
+        addFloat(rect.top_);
+        addFloat(rect.bottom_);
+    }
+
+    void CommandBuffer::setTransform(const AffineMatrix& transform)
+    {
+        addCommand(cSetTransformCommand,6);
+        addMatrix(transform);
+    }
+
+    void CommandBuffer::transform(const AffineMatrix& transform)
+    {
+        addCommand(cTransformCommand,6);
+        addMatrix(transform);
+    }
+
+    void CommandBuffer::addPath(const Path* path,const Pen* pen)
+    {
+        addPath(path,pen,0);
+    }
+
+    void CommandBuffer::addPath(const Path* path,const Brush* brush)
+    {
+        addPath(path,0,brush);
+    }
+
+    void CommandBuffer::addPath(const Path* path,const Pen* pen,const Brush* brush)
+    {
+        // Gradients are commands of their own, record them first
+        vplUint penGradient = pen ? addGradient(pen->getGradient()) : 0;
+        vplUint brushGradient = brush ? addGradient(brush->getGradient()) : 0;
+
+        const DynamicArray<Path::Segment>& segments = path->segments_;
+
+        vplUint size = 1 + cPathSize + cSegmentSize*segments.getItemCount();
+
+        if(pen)
+            size += cPenSize;
+
+        if(brush)
+            size += cBrushSize;
+
+        addCommand(cAddPathCommand,size);
+
+        words_.add((pen ? cPenFlag : 0) | (brush ? cBrushFlag : 0));
+
+        if(pen)
+        {
+            words_.add(pen->getColorAsARGB());
+            words_.add(penGradient);
+            addFloat(pen->getSize());
+            addFloat(pen->getMiterLimit());
+            words_.add(pen->getEndType());
+            words_.add(pen->getJoinType());
+            words_.add(pen->getBlendMode());
+        }
+
+        if(brush)
+        {
+            words_.add(brush->getColorAsARGB());
+            words_.add(brushGradient);
+            words_.add(brush->getBlendMode());
+            words_.add(brush->getFillMode());
+        }
+
+        addMatrix(path->getTransform());
+        words_.add(path->getFlattening());
+        addFloat(path->getFlatteningTolerance());
+        words_.add(segments.getItemCount());
+
+        for(vplUint i = 0; i < segments.getItemCount(); i++)
+        {
+            words_.add(segments[i].command_);
+
+            for(vplUint j = 0; j < 6; j++)
+                addFloat(segments[i].args_[j]);
+        }
+    }
+
+    void CommandBuffer::clearPaths()
+    {
+        addCommand(cClearPathsCommand,0);
+    }
+
+    void CommandBuffer::draw()
+    {
+        addCommand(cDrawCommand,0);
+    }
+
+    bool CommandBuffer::setData(const vplUint32* data,vplUint size)
+    {
+        clear();
+
+        if(size < cHeaderSize || data[0] != cCommandBufferMagic ||
+           data[1] != cCommandBufferVersion)
+            return false;
+
+        words_.resize(0);
+        words_.add(data,size);
+
+        if(!decode())
+        {
+            clear();
+
+            return false;
+        }
+
+        // Keep gradient indices in step for commands recorded after this
+        for(vplUint i = 0; i < gradients_.getItemCount(); i++)
+        {
+            recordedGradients_.add(0);
+            recordedPositions_.add(0);
+        }
+
+        return true;
+    }
+
+    void CommandBuffer::prepare()
+    {
+        decode();
+    }
+
+    // Check each command before building anything from it
+    bool CommandBuffer::decode()
+    {
+        const vplUint32* words = words_.getContents();
+        vplUint size = words_.getItemCount();
+        vplUint position = decodedSize_;
+
+        while(position < size)
+        {
+            if(size - position < 2 || size - position - 2 < words[position + 1])
+                return false;
+
+            const vplUint32* command = words + position + 2;
+            vplUint length = words[position + 1];
+
+            switch(words[position])
+            {
+                case cSetClipRectCommand:
+                    if(length != 4)
+                        return false;
+                    break;
+
+                case cSetTransformCommand:
+                case cTransformCommand:
+                    if(length != 6)
+                        return false;
+                    break;
+
+                case cClearPathsCommand:
+                case cDrawCommand:
+                    if(length != 0)
+                        return false;
+                    break;
+
+                case cAddGradientCommand:
+                {
+                    if(length < cGradientSize ||
+                       (length - cGradientSize) % 2 != 0 ||
+                       (length - cGradientSize)/2 != command[8] ||
+                       command[0] > Gradient::cRadial ||
+                       command[1] > Gradient::cRepeat ||
+                       command[2] > Gradient::cDirect)
+                        return false;
+
+                    // The color table is built from the stops, they must be
+                    // in order and inside the gradient
+                    float lastOffset = 0.0f;
+
+                    for(vplUint i = 0; i < command[8]; i++)
+                    {
+                        float offset = toFloat(command[cGradientSize + 2*i]);
+
+                        if(!(offset >= lastOffset && offset <= 1.0f))
+                            return false;
+
+                        lastOffset = offset;
+                    }
+
+                    Gradient* gradient;
+
+                    if(command[0] == Gradient::cLinear)
+                        gradient = new LinearGradient(toFloat(command[3]),toFloat(command[4]),
+                                                      toFloat(command[5]),toFloat(command[6]));
+                    else
+                        gradient = new RadialGradient(toFloat(command[3]),toFloat(command[4]),
+                                                      toFloat(command[5]),toFloat(command[6]),
+                                                      toFloat(command[7]));
+
+                    gradient->setSpread(static_cast<Gradient::Spread>(command[1]));
+                    gradient->setColorLookup(static_cast<Gradient::ColorLookup>(command[2]));
+
+                    for(vplUint i = 0; i < command[8]; i++)
+                        gradient->addStop(toFloat(command[cGradientSize + 2*i]),
+                                          Color(command[cGradientSize + 2*i + 1]));
+
+                    // Replays only read it from now on
+                    gradient->generateGradient();
+
+                    gradients_.add(gradient);
+                    break;
+                }
+
+                case cAddPathCommand:
+                {
+                    if(length < 1 || command[0] == 0 ||
+                       command[0] > (cPenFlag | cBrushFlag))
+                        return false;
+
+                    vplUint numGradients = gradients_.getItemCount();
+                    vplUint header = 1 + cPathSize;
+
+                    if(command[0] & cPenFlag)
+                    {
+                        if(length < 1 + cPenSize ||
+                           !isValidPen(command + 1,numGradients))
+                            return false;
+
+                        header += cPenSize;
+                    }
+
+                    if(command[0] & cBrushFlag)
+                    {
+                        if(length < header - cPathSize + cBrushSize ||
+                           !isValidBrush(command + header - cPathSize,numGradients))
+                            return false;
+
+                        header += cBrushSize;
+                    }
+
+                    const vplUint32* pathWords = command + header - cPathSize;
+
+                    if(length < header ||
+                       (length - header) % cSegmentSize != 0 ||
+                       (length - header)/cSegmentSize != pathWords[8] ||
+                       pathWords[6] > Path::cAnalytic)
+                        return false;
+
+                    Path* path = new Path();
+
+                    path->setTransform(toMatrix(pathWords));
+                    path->setFlattening(static_cast<Path::Flattening>(pathWords[6]),
+                                        toFloat(pathWords[7]));
+
+                    const vplUint32* segment = pathWords + cPathSize;
+
+                    for(vplUint i = 0; i < pathWords[8]; i++,segment += cSegmentSize)
+                    {
+                        if(!isValidSegment(segment[0]))
+                        {
+                            delete path;
+
+                            return false;
+                        }
+
+                        path->addSegment(static_cast<Path::Command>(segment[0]),
+                                         toFloat(segment[1]),toFloat(segment[2]),
+                                         toFloat(segment[3]),toFloat(segment[4]),
+                                         toFloat(segment[5]),toFloat(segment[6]));
+                    }
+
+                    // The path never changes, so renderers replaying it
+                    // have no reason to write to it
+                    path->segmentsValid_ = true;
+
+                    paths_.add(path);
+                    break;
+                }
+
+                default:
+                    return false;
+            }
+
+            position += 2 + length;
+            decodedSize_ = position;
+        }
+
+        return true;
+    }
+
+    void CommandBuffer::replay(Renderer& renderer)
+    {
+        prepare();
+
+        const vplUint32* words = words_.getContents();
+        vplUint position = cHeaderSize;
+        vplUint pathIndex = 0;
+
+        while(position < decodedSize_)
+        {
+            const vplUint32* command = words + position + 2;
+
+            switch(words[position])
+            {
+                case cSetClipRectCommand:
+                    renderer.setClipRect(Rect(toFloat(command[0]),toFloat(command[1]),
+                                              toFloat(command[2]),toFloat(command[3])));
+                    break;
+
+                case cSetTransformCommand:
+                    renderer.setTransform(toMatrix(command));
+                    break;
+
+                case cTransformCommand:
+                    renderer.transform(toMatrix(command));
+                    break;
+
+                case cAddPathCommand:
+                {
+                    Pen pen;
+                    Brush brush;
+                    const vplUint32* state = command + 1;
+
+                    if(command[0] & cPenFlag)
+                    {
+                        pen.setColor(Color(state[0]));
+                        pen.setGradient(toGradient(state[1],gradients_));
+                        pen.setSize(toFloat(state[2]));
+                        pen.setMiterLimit(toFloat(state[3]));
+                        pen.setEndType(static_cast<Stroker::EndType>(state[4]));
+                        pen.setJoinType(static_cast<Stroker::JoinType>(state[5]));
+                        pen.setBlendMode(static_cast<BlendMode>(state[6]));
+
+                        state += cPenSize;
+                    }
+
+                    if(command[0] & cBrushFlag)
+                    {
+                        brush.setColor(Color(state[0]));
+                        brush.setGradient(toGradient(state[1],gradients_));
+                        brush.setBlendMode(static_cast<BlendMode>(state[2]));
+                        brush.setFillMode(static_cast<Brush::FillMode>(state[3]));
+                    }
+
+                    renderer.addPath(paths_[pathIndex++],
+                                     (command[0] & cPenFlag) ? &pen : 0,
+                                     (command[0] & cBrushFlag) ? &brush : 0);
+                    break;
+                }
+
+                case cClearPathsCommand:
+                    renderer.clearPaths();
+                    break;
+
+                case cDrawCommand:
+                    renderer.draw();
+                    break;
+            }
+
+            position += 2 + words[position + 1];
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <nmmintrin.h>
+#include "vplBlendKernels.h"
+
+// Compiled with POPCNT enabled, only called when the processor has it
+namespace
+{
+    vplUint evenOddCoveragePopcnt(vplUint32* toggles,vplUint32* mask,
+                                  vplUint32 fullCoverage,
+                                  vplUint32* coverage,vplUint count)
+    {
+        vplUint32 current = *mask;
+        vplUint i = 0;
+
+        while(i < count)
+        {
+            coverage[i] = static_cast<vplUint32>(_mm_popcnt_u32(current));
+            current ^= toggles[i];
+            toggles[i++] = 0;
+
+            if(current == 0 || current == fullCoverage)
+                break;
+        }
+
+        *mask = current;
+
+        return i;
+    }
+}
+
+namespace vpl
+{
+    void setBlendKernelsPopcnt(BlendKernels& kernels)
+    {
+        kernels.evenOddCoverage_ = &evenOddCoveragePopcnt;
+    }
+}
@@ -18,19 +18,20 @@
 #ifndef VPL_EDGE_H_INCLUDED_
 #define VPL_EDGE_H_INCLUDED_
 
+#include "vplArray.h"
 #include "vplVector.h"
 #include "vplFixedPoint.h"
 #include "vplLog.h"
 
 namespace vpl
 {
+    // 16 bytes, scanlines are in subpixels and the winding shares a
+    // word with the last scanline
 	class Edge
     {
     public:
 
-        Edge():nextEdge_(0),firstScanLine_(0),lastScanLine_(0),winding_(0){}
-        ~Edge(){}
-
+        Edge():firstScanLine_(0),lastScanLine_(0),winding_(0){}
 
         // Create edge between two points
         inline void makeEdge(const float p1x,const float p1y,
@@ -58,78 +59,80 @@ namespace vpl
 			    slope_ = FixedPoint(0);
 	    }
 
-        // Insert edge
-        inline void insert(Edge* edge)
-        {
-            // TODO: Find out why this is needed
-            // Avoid circular lists
-            if(this == nextEdge_ || edge == this)
-				return;
-            
-            edge->nextEdge_ = nextEdge_;
-            nextEdge_       = edge;
-        }
-       
         // Data
         FixedPoint x_;
         FixedPoint slope_;
-        Edge*      nextEdge_;
         int        firstScanLine_;
-        int        lastScanLine_;
-        int        winding_;
+        signed int lastScanLine_ : 30;
+        signed int winding_ : 2;
     };
     
+    // Edges that cross the current scanline. The list holds copies so the
+    // edges in the scanline list are left untouched by a fill. The copies
+    // are kept in one array, a removed edge is replaced by the last one so
+    // the order is arbitrary. Pointers to edges are valid until the next
+    // insert or remove.
     class ActiveEdgeList
     {
     public:
-        
-        ActiveEdgeList():list_(0){}
-        ~ActiveEdgeList(){}
-        
-        inline Edge* getList()   {return list_;}
-        inline void  clearList() {list_ = 0;}
-        inline Edge* insertAndGetNext(Edge* edge)
+
+        ActiveEdgeList():edges_(0),count_(0),capacity_(0){}
+        ~ActiveEdgeList()
+        {
+            if(edges_)
+                delete [] edges_;
+        }
+
+        inline vplUint getCount() const {return count_;}
+        inline Edge* getEdge(vplUint index) {return &edges_[index];}
+
+        // Release all active edges
+        inline void clearList()
+        {
+            count_ = 0;
+        }
+
+        // Insert a copy of edge, the copy is returned
+        inline Edge* insert(const Edge& edge)
         {
-            Edge* next = edge->nextEdge_;
-            
-            edge->nextEdge_ = 0;
-            
-            if(list_)
-                list_->insert(edge);
-            else
-                list_ = edge;
-            
-            return next;
+            if(count_ == capacity_)
+                grow();
+
+            Edge* active = &edges_[count_++];
+
+            *active = edge;
+
+            return active;
         }
-        
-        inline void remove(Edge* edge)
+
+        // Remove an edge, the last edge is moved to its index
+        inline void remove(vplUint index)
         {
-            Edge* next = list_;
-            Edge* prev = 0;
-
-            // Find edge
-            while(next)
-            {
-                // If found
-                if(next == edge)
-                {
-                    // Update node and break loop
-                    if(prev)
-                        prev->nextEdge_ = next->nextEdge_;
-                    else
-                        list_ = next->nextEdge_;
-                    
-                    break;
-                }
-                
-                prev = next;
-				next = next->nextEdge_;
-            }
+            edges_[index] = edges_[--count_];
         }
-        
+
     private:
-        
-        Edge* list_;
+
+        void grow()
+        {
+            vplUint capacity = capacity_ ? capacity_*2 : cInitialSize;
+            Edge* edges = new Edge[capacity];
+
+            for(vplUint i = 0; i < count_; i++)
+                edges[i] = edges_[i];
+
+            if(edges_)
+                delete [] edges_;
+
+            edges_ = edges;
+            capacity_ = capacity;
+        }
+
+        static const vplUint cInitialSize = 128;
+
+        Edge* edges_;
+        vplUint count_;
+        vplUint capacity_;
     };
 }
 #endif
@@ -16,8 +16,8 @@
  */
 
 #include <cfloat>
+#include <cmath>
 #include "vplEdgeGenerator.h"
-#include "vplStroke.h"
 
 namespace vpl
 {
@@ -26,7 +26,7 @@ namespace vpl
 
     // Fill edge creation
     static void createEdges(DynamicArray<float>& points,
-                            ScanLineList* scanLineList)
+                            DynamicArray<Edge>& edges)
     {
         // Make sure path is closed
         points.add(points[0]);
@@ -38,6 +38,8 @@ namespace vpl
         if(numPoints < 3)
             return;
 
+        edges.reserve(edges.getItemCount() + numPoints - 1);
+
         for(vplUint i = 0; i < numPoints - 1;i++)
         {
             Edge edge;
@@ -51,13 +53,13 @@ namespace vpl
             else
                 edge.winding_ = cNegativeWinding;
 
-            scanLineList->insert(edge);
+            edges.add(edge);
         }
     }
 
     // Stroke edge creation
     static void createEdges(DynamicArray<float>& points,
-                            ScanLineList* scanLineList,
+                            DynamicArray<Edge>& edges,
                             int winding)
     {
         // Make sure path is closed
@@ -70,6 +72,8 @@ namespace vpl
         if(numPoints < 3)
             return;
 
+        edges.reserve(edges.getItemCount() + numPoints - 1);
+
         for(vplUint i = 0; i < numPoints - 1;i++)
         {
             Edge edge;
@@ -83,7 +87,7 @@ namespace vpl
             else
                 edge.winding_ = cNegativeWinding*winding;
 
-            scanLineList->insert(edge);
+            edges.add(edge);
         }
     }
 
@@ -123,93 +127,238 @@ namespace vpl
             internalClipRect_.top_ = viewPort.top_;
     }
 
+    void EdgeGenerator::addToBounds(const DynamicArray<float>& points)
+    {
+        for(vplUint i = 0; i + 1 < points.getItemCount(); i += 2)
+        {
+            if(points[i] < minX_)
+                minX_ = points[i];
+            if(points[i] > maxX_)
+                maxX_ = points[i];
+            if(points[i + 1] < minY_)
+                minY_ = points[i + 1];
+            if(points[i + 1] > maxY_)
+                maxY_ = points[i + 1];
+        }
+    }
+
     void EdgeGenerator::generateEdges(PathReference* reference)
     {
+        minX_ = minY_ = FLT_MAX;
+        maxX_ = maxY_ = -FLT_MAX;
+
         // Generate fill edges
         if(reference->fillEdges_)
         {
             SubPath* subPath = reference->generator_->beginSubPathIteration();
 
             reference->fillEdges_->init(static_cast<vplUint>(height_),
-                                        reference->generator_->getNumberOfPoints(),
                                         subPixelCount_);
 
+            edges_.clear();
+
             updateInternalClipRect();
 
-            DynamicArray<float> clippedPoints;
+            // Iterate over all subpaths and add edges, unless the path
+            // is outside
+            bool visible = computeOverlap(reference->generator_->getBounds(),
+                                          0.0f,0.0f) != cOutside;
 
-            // Iterate over all subpaths and add edges
-            while(reference->generator_->hasMoreSubPaths())
+            while(visible && reference->generator_->hasMoreSubPaths())
             {
-                Edge edge;
+                Overlap overlap = computeOverlap(subPath->getBounds(),0.0f,0.0f);
+
+                if(overlap != cOutside)
+                {
+                    // Clip points
+                    const float* points = subPath->getPoints();
 
-                // Clip points
-                const float* points = subPath->getPoints();
+                    clippedPoints_.clear();
 
-                clippedPoints.clear();
+                    if(overlap == cInside)
+                        copy(points,subPath->getNumberOfPoints(),clippedPoints_);
+                    else
+                        clip(points,subPath->getNumberOfPoints(),clippedPoints_);
 
-                clip(points,subPath->getNumberOfPoints(),clippedPoints);
+                    addToBounds(clippedPoints_);
 
-                createEdges(clippedPoints,reference->fillEdges_);
+                    createEdges(clippedPoints_,edges_);
+                }
 
                 // Advance to next subpath
                 subPath = reference->generator_->getNextSubPath();
             }
+
+            reference->fillEdges_->setEdges(edges_.getContents(),
+                                            edges_.getItemCount());
         }
 
         // Generate stroke edges
         if(reference->strokeEdges_)
         {
             // Generate two contours
-            Stroker stroker(reference->pen_.getJoinType(),
-                            reference->pen_.getEndType(),
-                            reference->pen_.getSize(),
-                            reference->pen_.getMiterLimit());
+            stroker_.setStyle(reference->pen_.getJoinType(),
+                              reference->pen_.getEndType(),
+                              reference->pen_.getSize(),
+                              reference->pen_.getMiterLimit());
 
             SubPath* subPath = reference->generator_->beginSubPathIteration();
 
             reference->strokeEdges_->init(static_cast<vplUint>(height_),
-                                          reference->generator_->getNumberOfPoints()*4,
                                           subPixelCount_);
 
-            updateInternalClipRect();
+            edges_.clear();
 
-            DynamicArray<float> clippedPoints;
+            updateInternalClipRect();
 
             AffineMatrix finalPathTransform = reference->path_->getTransform();
 
             finalPathTransform *= reference->externalTransform_;
 
-            // Iterate over all subpaths and add edges
-            while(reference->generator_->hasMoreSubPaths())
-            {
-                stroker.generateStrokeOutlines(subPath,finalPathTransform);
+            // How far the outlines can reach past the points. Miters end
+            // within the miter limit, caps and round joins within twice
+            // the half width
+            const float* matrix = finalPathTransform.getMatrix();
+
+            float reach = reference->pen_.getSize()/2.0f;
+
+            if(reference->pen_.getMiterLimit() > 2.0f)
+                reach *= reference->pen_.getMiterLimit();
+            else
+                reach *= 2.0f;
 
-                // Clip points
-                clippedPoints.clear();
+            float marginX = reach*(std::fabs(matrix[0]) + std::fabs(matrix[1])) + 1.0f;
+            float marginY = reach*(std::fabs(matrix[3]) + std::fabs(matrix[4])) + 1.0f;
 
-                clip(stroker.getOuterPoints(),
-                     stroker.getNumberOfOuterPoints(),clippedPoints);
+            // Iterate over all subpaths and add edges, unless the path
+            // is outside
+            bool visible = computeOverlap(reference->generator_->getBounds(),
+                                          marginX,marginY) != cOutside;
 
-                createEdges(clippedPoints,reference->strokeEdges_);
+            while(visible && reference->generator_->hasMoreSubPaths())
+            {
+                Overlap overlap = computeOverlap(subPath->getBounds(),marginX,marginY);
 
-                // Do inner points (only if path is not closed)
-                if(stroker.getNumberOfInnerPoints())
+                if(overlap != cOutside)
                 {
-                    clippedPoints.clear();
+                    stroker_.generateStrokeOutlines(subPath,finalPathTransform);
+
+                    // Clip points, the margin is only an estimate so
+                    // look at the outlines themselves
+                    clippedPoints_.clear();
+
+                    clipOutline(stroker_.getOuterPoints(),
+                                stroker_.getNumberOfOuterPoints(),clippedPoints_);
+
+                    addToBounds(clippedPoints_);
 
-                    clip(stroker.getInnerPoints(),
-                         stroker.getNumberOfInnerPoints(),
-                         clippedPoints);
+                    createEdges(clippedPoints_,edges_);
 
-                    createEdges(clippedPoints,reference->strokeEdges_,cNegativeWinding);
+                    // Do inner points (only if path is not closed)
+                    if(stroker_.getNumberOfInnerPoints())
+                    {
+                        clippedPoints_.clear();
+
+                        clipOutline(stroker_.getInnerPoints(),
+                                    stroker_.getNumberOfInnerPoints(),
+                                    clippedPoints_);
+
+                        addToBounds(clippedPoints_);
+
+                        createEdges(clippedPoints_,edges_,cNegativeWinding);
+                    }
                 }
 
                 // Advance to next subpath
                 subPath = reference->generator_->getNextSubPath();
             }
+
+            reference->strokeEdges_->setEdges(edges_.getContents(),
+                                              edges_.getItemCount());
         }
+
+        // Pixels covered, with one to spare on each side for edges
+        // that end in a pixel
+        if(minX_ <= maxX_)
+        {
+            int subPixels = static_cast<int>(subPixelCount_);
+
+            Rect bounds(static_cast<float>(static_cast<int>(minX_) - 1),
+                        static_cast<float>(static_cast<int>(maxX_) + 2),
+                        static_cast<float>(static_cast<int>(maxY_) / subPixels + 2),
+                        static_cast<float>(static_cast<int>(minY_) / subPixels - 1));
+
+            bounds.intersect(Rect(0.0f,width_,height_,0.0f));
+
+            reference->bounds_ = bounds;
+        }
+        else
+            reference->bounds_ = Rect();
     }
+    EdgeGenerator::Overlap EdgeGenerator::computeOverlap(const Rect& bounds,
+                                                         float marginX,
+                                                         float marginY) const
+    {
+        float left   = bounds.left_ - marginX;
+        float right  = bounds.right_ + marginX;
+        float top    = bounds.top_ + marginY;
+        float bottom = bounds.bottom_ - marginY;
+
+        if(right < internalClipRect_.left_ || left > internalClipRect_.right_ ||
+           top < internalClipRect_.bottom_ || bottom > internalClipRect_.top_)
+            return cOutside;
+
+        if(left >= internalClipRect_.left_ && right <= internalClipRect_.right_ &&
+           bottom >= internalClipRect_.bottom_ && top <= internalClipRect_.top_)
+            return cInside;
+
+        return cPartial;
+    }
+
+    // Outlines have no bounds of their own, find them first
+    void EdgeGenerator::clipOutline(const float* points,
+                                    const vplUint numPoints,
+                                    DynamicArray<float>& out)
+    {
+        if(numPoints == 0)
+            return;
+
+        Rect bounds(points[0],points[0],points[1],points[1]);
+
+        for(vplUint i = 1; i < numPoints; i++)
+        {
+            if(points[2*i] < bounds.left_)
+                bounds.left_ = points[2*i];
+            if(points[2*i] > bounds.right_)
+                bounds.right_ = points[2*i];
+            if(points[2*i + 1] < bounds.bottom_)
+                bounds.bottom_ = points[2*i + 1];
+            if(points[2*i + 1] > bounds.top_)
+                bounds.top_ = points[2*i + 1];
+        }
+
+        Overlap overlap = computeOverlap(bounds,0.0f,0.0f);
+
+        if(overlap == cInside)
+            copy(points,numPoints,out);
+        else if(overlap == cPartial)
+            clip(points,numPoints,out);
+    }
+
+    // Clipping leaves points inside untouched but starts with the second
+    // point, keep that order so the edges are the same
+    void EdgeGenerator::copy(const float* points,
+                             const vplUint numPoints,
+                             DynamicArray<float>& out)
+    {
+        if(numPoints == 0)
+            return;
+
+        out.add(points + 2,2*(numPoints - 1));
+        out.add(points[0]);
+        out.add(points[1]);
+    }
+
     // Clipping using liang barsky algorithm
     static const float cVplInfinity = FLT_MAX;
 
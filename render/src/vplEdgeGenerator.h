@@ -24,13 +24,15 @@
 #include "vplRect.h"
 #include "vplRender.h"
 #include "vplScanLineList.h"
+#include "vplStroke.h"
 
 namespace vpl
 {
     class VPL_API PathReference
 	{
 	public:
-		PathReference():fillEdges_(0),strokeEdges_(0),generator_(0){}
+		PathReference():fillEdges_(0),strokeEdges_(0),generator_(0),
+                        edgesValid_(false),pointsValid_(false),slot_(0){}
 		~PathReference(){}
 
 	private:
@@ -45,13 +47,26 @@ namespace vpl
 		ScanLineList* strokeEdges_;
         PointGenerator* generator_;
         AffineMatrix externalTransform_;
+        // Path transform combined with the renderer transform, the edges
+        // are kept until this or the path changes
+        AffineMatrix edgeTransform_;
+        bool edgesValid_;
+        // The generator holds the flattened path, it only needs a new
+        // transform
+        bool pointsValid_;
+        // Pixels the edges can touch
+        Rect bounds_;
+        // Index in the renderer's path array
+        vplUint slot_;
 	};
 
 	class VPL_API EdgeGenerator
 	{
     public:
 
-        EdgeGenerator():width_(0.0f),height_(0.0f),subPixelCount_(32){}
+        EdgeGenerator():stroker_(Stroker::cBevelJoin,Stroker::cButtEnd,1.0f,4.0f),
+                        width_(0.0f),height_(0.0f),subPixelCount_(32),
+                        minX_(0.0f),maxX_(0.0f),minY_(0.0f),maxY_(0.0f){}
         ~EdgeGenerator(){}
 
         void initialize(vplUint subPixelCount,float width,float height);
@@ -62,19 +77,55 @@ namespace vpl
 
     private:
 
+        // Where points lie compared to the internal clip rect
+        enum Overlap
+        {
+            cOutside,
+            cPartial,
+            cInside
+        };
+
+        // The bounds are grown by the margins first
+        Overlap computeOverlap(const Rect& bounds,
+                               float marginX,float marginY) const;
+
          // Clipping of edges
         void clip(const float* points,
                   const vplUint numPointsIn,
                   DynamicArray<float>& out);
 
+        // Same output as clip for points inside the clip rect
+        void copy(const float* points,
+                  const vplUint numPoints,
+                  DynamicArray<float>& out);
+
+        // Clip, copy or drop points depending on their bounds
+        void clipOutline(const float* points,
+                         const vplUint numPoints,
+                         DynamicArray<float>& out);
+
         // Calculate internal clip rect
         void updateInternalClipRect();
 
+        // Add clipped points to the bounds of the current path
+        void addToBounds(const DynamicArray<float>& points);
+
         Rect  clipRect_;
         Rect  internalClipRect_;
+        // Reused between paths to keep its storage
+        DynamicArray<float> clippedPoints_;
+        // Edges of the current list before they are sorted
+        DynamicArray<Edge> edges_;
+        // Outlines of the current stroke, the stroker keeps its storage
+        Stroker stroker_;
         float width_;
         float height_;
         vplUint  subPixelCount_;
+        // Bounds in subpixels of the current path
+        float minX_;
+        float maxX_;
+        float minY_;
+        float maxY_;
 	};
 }
 
@@ -428,29 +428,4 @@ namespace vpl
         // Update the edge
         edge->x_ = x;
     }
-
-    IEvenOddMaskGenerator& chooseEvenOddMaskGen(vplUint subPixelCount)
-    {
-        switch(subPixelCount)
-        {
-            case 32:
-			{
-                static EvenOddMaskGenerator32 eom32;
-                return eom32;
-			}
-
-            case 16:
-			{
-                static EvenOddMaskGenerator16 eom16;
-                return eom16;
-			}
-
-            case 8:
-            default:
-			{
-                static EvenOddMaskGenerator8 eom8;
-                return eom8;
-			}
-        }
-    }
 }
\ No newline at end of file
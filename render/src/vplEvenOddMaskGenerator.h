@@ -81,7 +81,5 @@ namespace vpl
         void processEdge(Edge* edge);
 	};
 
-    IEvenOddMaskGenerator& chooseEvenOddMaskGen(vplUint subPixelCount);
-
 }
 #endif
\ No newline at end of file
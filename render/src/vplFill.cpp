@@ -105,9 +105,32 @@ namespace vpl
             }
         }
     }
+    void fillPath(const FillJob& job,PixelBuffer* target,
+                  FillParameters& params,FillState* state)
+    {
+        if(job.fillMode_ == Brush::cEvenOdd)
+        {
+            if(job.gradient_)
+                gradientFillEvenOdd(job.blendMode_,target,job.edges_,
+                                    job.gradient_,params,state);
+            else
+                fillEvenOdd(job.blendMode_,target,job.edges_,
+                            job.color_,params,state);
+        }
+        else
+        {
+            if(job.gradient_)
+                gradientFillNonZero(job.blendMode_,target,job.edges_,
+                                    job.gradient_,params,state);
+            else
+                fillNonZero(job.blendMode_,target,job.edges_,
+                            job.color_,params,state);
+        }
+    }
+
     void fillEvenOdd(BlendMode blendMode,PixelBuffer* target,ScanLineList* edges,
                      vplUint32 color,FillParameters& params,
-                     EvenOddMaskBuffer* evenOddMaskBuffer)
+                     FillState* state)
     {
         switch(blendMode)
         {
@@ -118,7 +141,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrc:
@@ -128,7 +151,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDest:
@@ -138,7 +161,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestOverSrc:
@@ -148,7 +171,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrcInDest:
@@ -158,7 +181,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestInSrc:
@@ -168,7 +191,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cClear:
@@ -178,7 +201,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrcOutDest:
@@ -188,7 +211,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestOutSrc:
@@ -198,7 +221,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrcAtopDest:
@@ -208,7 +231,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestAtopSrc:
@@ -218,7 +241,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrcXorDest:
@@ -228,7 +251,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             default:
@@ -238,16 +261,16 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
         }
     }
 
     void gradientFillEvenOdd(BlendMode blendMode,PixelBuffer* target,
-							 ScanLineList* edges,Gradient* gradient,
+							 ScanLineList* edges,const Gradient* gradient,
 							 FillParameters& params,
-                             EvenOddMaskBuffer* evenOddMaskBuffer)
+                             FillState* state)
     {
         switch(blendMode)
         {
@@ -256,9 +279,9 @@ namespace vpl
                 SrcOverDestGradientBlender blender;
                 EvenOddFiller<SrcOverDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrc:
@@ -266,9 +289,9 @@ namespace vpl
                 SrcGradientBlender blender;
                 EvenOddFiller<SrcGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDest:
@@ -276,9 +299,9 @@ namespace vpl
                 DestGradientBlender blender;
                 EvenOddFiller<DestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestOverSrc:
@@ -286,9 +309,9 @@ namespace vpl
                 DestOverSrcGradientBlender blender;
                 EvenOddFiller<DestOverSrcGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrcInDest:
@@ -296,9 +319,9 @@ namespace vpl
                 SrcInDestGradientBlender blender;
                 EvenOddFiller<SrcInDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestInSrc:
@@ -306,9 +329,9 @@ namespace vpl
                 DestInSrcGradientBlender blender;
                 EvenOddFiller<DestInSrcGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cClear:
@@ -318,7 +341,7 @@ namespace vpl
 
                 blender.setColor(0);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrcOutDest:
@@ -326,9 +349,9 @@ namespace vpl
                 SrcOutDestGradientBlender blender;
                 EvenOddFiller<SrcOutDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestOutSrc:
@@ -336,9 +359,9 @@ namespace vpl
                 DestOutSrcGradientBlender blender;
                 EvenOddFiller<DestOutSrcGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrcAtopDest:
@@ -346,9 +369,9 @@ namespace vpl
                 SrcAtopDestGradientBlender blender;
                 EvenOddFiller<SrcAtopDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestAtopSrc:
@@ -356,9 +379,9 @@ namespace vpl
                 DestAtopSrcGradientBlender blender;
                 EvenOddFiller<DestAtopSrcGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrcXorDest:
@@ -366,9 +389,9 @@ namespace vpl
                 SrcXorDestGradientBlender blender;
                 EvenOddFiller<SrcXorDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             default:
@@ -376,9 +399,9 @@ namespace vpl
                 SrcOverDestGradientBlender blender;
                 EvenOddFiller<SrcOverDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,evenOddMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
         }
@@ -386,7 +409,7 @@ namespace vpl
 
     void fillNonZero(BlendMode blendMode,PixelBuffer* target,ScanLineList* edges,
                      vplUint32 color,FillParameters& params,
-                     NonZeroMaskBuffer* nonZeroMaskBuffer)
+                     FillState* state)
     {
         switch(blendMode)
         {
@@ -397,7 +420,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -408,7 +431,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -419,7 +442,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -430,7 +453,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -441,7 +464,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -452,7 +475,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -463,7 +486,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -474,7 +497,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -485,7 +508,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -496,7 +519,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -507,7 +530,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -518,7 +541,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -529,7 +552,7 @@ namespace vpl
 
                 blender.setColor(color);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
 
             }
             break;
@@ -537,9 +560,9 @@ namespace vpl
     }
 
     void gradientFillNonZero(BlendMode blendMode,PixelBuffer* target,
-		                     ScanLineList* edges,Gradient* gradient,
+		                     ScanLineList* edges,const Gradient* gradient,
 							 FillParameters& params,
-                             NonZeroMaskBuffer* nonZeroMaskBuffer)
+                             FillState* state)
     {
         switch(blendMode)
         {
@@ -548,9 +571,9 @@ namespace vpl
                 SrcOverDestGradientBlender blender;
                 NonZeroFiller<SrcOverDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrc:
@@ -558,9 +581,9 @@ namespace vpl
                 SrcGradientBlender blender;
                 NonZeroFiller<SrcGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDest:
@@ -568,9 +591,9 @@ namespace vpl
                 DestGradientBlender blender;
                 NonZeroFiller<DestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestOverSrc:
@@ -578,9 +601,9 @@ namespace vpl
                 DestOverSrcGradientBlender blender;
                 NonZeroFiller<DestOverSrcGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrcInDest:
@@ -588,9 +611,9 @@ namespace vpl
                 SrcInDestGradientBlender blender;
                 NonZeroFiller<SrcInDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestInSrc:
@@ -598,9 +621,9 @@ namespace vpl
                 DestInSrcGradientBlender blender;
                 NonZeroFiller<DestInSrcGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cClear:
@@ -610,7 +633,7 @@ namespace vpl
 
                 blender.setColor(0);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrcOutDest:
@@ -618,9 +641,9 @@ namespace vpl
                 SrcOutDestGradientBlender blender;
                 NonZeroFiller<SrcOutDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestOutSrc:
@@ -628,9 +651,9 @@ namespace vpl
                 DestOutSrcGradientBlender blender;
                 NonZeroFiller<DestOutSrcGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);;
+                filler.fill(target,edges,blender,params,state);;
             }
             break;
             case cSrcAtopDest:
@@ -638,9 +661,9 @@ namespace vpl
                 SrcAtopDestGradientBlender blender;
                 NonZeroFiller<SrcAtopDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cDestAtopSrc:
@@ -648,9 +671,9 @@ namespace vpl
                 DestAtopSrcGradientBlender blender;
                 NonZeroFiller<DestAtopSrcGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             case cSrcXorDest:
@@ -658,9 +681,9 @@ namespace vpl
                 SrcXorDestGradientBlender blender;
                 NonZeroFiller<SrcXorDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
             default:
@@ -668,9 +691,9 @@ namespace vpl
                 SrcOverDestGradientBlender blender;
                 NonZeroFiller<SrcOverDestGradientBlender> filler;
 
-                blender.setGradient(gradient);
+                blender.setGradient(gradient,state->gradientPixels_);
 
-                filler.fill(target,edges,blender,params,nonZeroMaskBuffer);
+                filler.fill(target,edges,blender,params,state);
             }
             break;
         }
@@ -18,6 +18,7 @@
 #ifndef VPL_FILL_H_INCLUDED_
 #define VPL_FILL_H_INCLUDED_
 
+#include <cmath>
 #include "vplConfig.h"
 #include "vplBlend.h"
 #include "vplEdge.h"
@@ -38,6 +39,19 @@ namespace vpl
         vplUint subPixelCount_;
         vplUint maxCoverage_;
         vplUint subPixelShift_;
+        // Range of scanlines and columns to fill, inclusive
+        int firstLine_;
+        int lastLine_;
+        int firstColumn_;
+        int lastColumn_;
+        // Exact area coverage instead of sample masks
+        bool areaCoverage_;
+        // Edges starting above firstLine_ that reach it, found by the
+        // band renderer when the fill was queued. Without them the edge
+        // list is searched
+        bool hasCrossingEdges_;
+        const Edge* const* crossingEdges_;
+        vplUint numCrossingEdges_;
     };
 
     struct EvenOddMaskBuffer
@@ -70,10 +84,415 @@ namespace vpl
         int width_;
     };
 
+    // Signed area and cover accumulated per pixel of a scanline
+    struct AreaCoverageBuffer
+    {
+        AreaCoverageBuffer():cells_(0),width_(0){}
+        ~AreaCoverageBuffer()
+        {
+            if(cells_)
+                delete [] cells_;
+        }
+
+        // Only allocate new space if needed, the cells are left cleared
+        // after every scanline
+        inline void initialize(int width)
+        {
+            if(width > width_)
+            {
+                if(width_ > 0)
+                    delete [] cells_;
+
+                cells_ = new float[width];
+
+                for(int i = 0; i < width; i++)
+                    cells_[i] = 0.0f;
+
+                width_ = width;
+            }
+        }
+
+        float* cells_;
+        int width_;
+    };
+
+    // Scratch memory and mask generators used while filling, every
+    // thread that fills needs a state of its own
+    struct FillState
+    {
+        FillState():evenOddMaskGen_(&evenOddMaskGen8_),
+                    nonZeroMaskGen_(&nonZeroMaskGen8_){}
+
+        // Choose mask generators for sampling
+        inline void setSubPixelCount(vplUint subPixelCount)
+        {
+            switch(subPixelCount)
+            {
+                case 32:
+                    evenOddMaskGen_ = &evenOddMaskGen32_;
+                    nonZeroMaskGen_ = &nonZeroMaskGen32_;
+                    break;
+
+                case 16:
+                    evenOddMaskGen_ = &evenOddMaskGen16_;
+                    nonZeroMaskGen_ = &nonZeroMaskGen16_;
+                    break;
+
+                case 8:
+                default:
+                    evenOddMaskGen_ = &evenOddMaskGen8_;
+                    nonZeroMaskGen_ = &nonZeroMaskGen8_;
+                    break;
+            }
+        }
+
+        EvenOddMaskBuffer evenOddMaskBuffer_;
+        NonZeroMaskBuffer nonZeroMaskBuffer_;
+        AreaCoverageBuffer areaCoverageBuffer_;
+        ActiveEdgeList activeEdges_;
+        // Gradient pixels of the span being blended
+        vplUint32 gradientPixels_[cGradientSpanLength];
+        IEvenOddMaskGenerator* evenOddMaskGen_;
+        INonZeroMaskGenerator* nonZeroMaskGen_;
+
+    private:
+
+        EvenOddMaskGenerator8 evenOddMaskGen8_;
+        EvenOddMaskGenerator16 evenOddMaskGen16_;
+        EvenOddMaskGenerator32 evenOddMaskGen32_;
+        NonZeroMaskGenerator8 nonZeroMaskGen8_;
+        NonZeroMaskGenerator16 nonZeroMaskGen16_;
+        NonZeroMaskGenerator32 nonZeroMaskGen32_;
+    };
+
+    // Make an edge active and move it down to firstSubLine
+    inline void activateEdge(const Edge& edge,ActiveEdgeList& activeEdges,
+                             int firstSubLine)
+    {
+        Edge* active = activeEdges.insert(edge);
+
+        active->x_ += active->slope_ * (firstSubLine - active->firstScanLine_);
+        active->firstScanLine_ = firstSubLine;
+    }
+
+    // Make the edges that start above the first scanline to fill active
+    // and move them down to it
+    inline void activateEdges(ScanLineList* allEdges,
+                              ActiveEdgeList& activeEdges,
+                              const FillParameters& params)
+    {
+        int firstSubLine = params.firstLine_ << params.subPixelShift_;
+
+        if(params.hasCrossingEdges_)
+        {
+            for(vplUint i = 0; i < params.numCrossingEdges_; i++)
+                activateEdge(*params.crossingEdges_[i],activeEdges,firstSubLine);
+
+            return;
+        }
+
+        for(int y = allEdges->getMin(); y < params.firstLine_; ++y)
+        {
+            const Edge* edge = allEdges->getLine(y);
+            const Edge* lastEdge = allEdges->getLineEnd(y);
+
+            for(; edge != lastEdge; ++edge)
+            {
+                if((edge->lastScanLine_ >> params.subPixelShift_) >= params.firstLine_)
+                    activateEdge(*edge,activeEdges,firstSubLine);
+            }
+        }
+    }
+
+    // Blend a run of fully covered pixels, the part outside the
+    // columns to fill is left alone
+    template<typename T> inline void blendRun(T& blender,vplUint32* pixels,
+                                              int x,int y,vplUint count,
+                                              const FillParameters& params)
+    {
+        int first = x;
+        int last = x + static_cast<int>(count) - 1;
+
+        if(first < params.firstColumn_)
+            first = params.firstColumn_;
+
+        if(last > params.lastColumn_)
+            last = params.lastColumn_;
+
+        if(first <= last)
+            blender.blend(pixels + first,first,y,last - first + 1);
+    }
+
+    // Add a line that lies within one scanline to the cells. The
+    // height is signed with the winding and in fractions of a pixel. The
+    // pixel the line passes gets the area to the right of it, the rest
+    // of the height is carried to the next pixel and summed up later.
+    inline void accumulateLine(float* cells,float x0,float x1,float height,
+                               float width,HorizontalSpan& xSpan)
+    {
+        if(x0 > x1)
+        {
+            float temp = x0;
+            x0 = x1;
+            x1 = temp;
+        }
+
+        if(x0 < 0.0f)
+            x0 = 0.0f;
+
+        if(x1 > width)
+            x1 = width;
+
+        if(x0 > x1)
+            x0 = x1;
+
+        int first = static_cast<int>(x0);
+        int last = static_cast<int>(std::ceil(x1));
+
+        // Within one pixel
+        if(last <= first + 1)
+        {
+            float middle = 0.5f * (x0 + x1) - first;
+
+            cells[first] += height - height * middle;
+            cells[first + 1] += height * middle;
+
+            xSpan.mark(first,first + 1);
+
+            return;
+        }
+
+        // Spans several pixels, the height per pixel is constant
+        float step = 1.0f / (x1 - x0);
+        float firstFraction = x0 - first;
+        float firstArea = 0.5f * step * (1.0f - firstFraction) * (1.0f - firstFraction);
+        float lastFraction = x1 - last + 1;
+        float lastArea = 0.5f * step * lastFraction * lastFraction;
+
+        cells[first] += height * firstArea;
+
+        if(last == first + 2)
+            cells[first + 1] += height * (1.0f - firstArea - lastArea);
+        else
+        {
+            float area = step * (1.5f - firstFraction);
+
+            cells[first + 1] += height * (area - firstArea);
+
+            for(int x = first + 2; x < last - 1; x++)
+                cells[x] += height * step;
+
+            area += (last - first - 3) * step;
+
+            cells[last - 1] += height * (1.0f - area - lastArea);
+        }
+
+        cells[last] += height * lastArea;
+
+        xSpan.mark(first,last);
+    }
+
+    // Add the part of an edge that lies within a scanline and move the
+    // edge to where the next scanline starts
+    inline void accumulateEdge(float* cells,Edge* edge,int lineEnd,
+                               const FillParameters& params,HorizontalSpan& xSpan)
+    {
+        int end = edge->lastScanLine_ < lineEnd ? edge->lastScanLine_ : lineEnd;
+        int rows = end - edge->firstScanLine_;
+
+        if(rows <= 0)
+            return;
+
+        FixedPoint x = edge->x_ + edge->slope_ * rows;
+        float height = static_cast<float>(rows * edge->winding_) /
+                       static_cast<float>(params.subPixelCount_);
+
+        accumulateLine(cells,edge->x_.toFloat(),x.toFloat(),height,
+                       static_cast<float>(params.width_),xSpan);
+
+        edge->x_ = x;
+        edge->firstScanLine_ = end;
+    }
+
+    // Alpha from 0 to 256 for accumulated winding
+    inline vplUint32 getAreaCoverage(float winding,bool evenOdd)
+    {
+        float coverage = std::fabs(winding);
+
+        if(evenOdd)
+        {
+            coverage -= 2.0f * std::floor(coverage * 0.5f);
+
+            if(coverage > 1.0f)
+                coverage = 2.0f - coverage;
+        }
+        else if(coverage > 1.0f)
+            coverage = 1.0f;
+
+        return static_cast<vplUint32>(coverage * 256.0f + 0.5f);
+    }
+
+    // Analytic filler, computes the area of every pixel that is covered
+    // in one pass per scanline. Edges are exact horizontally and placed
+    // at subpixel rows vertically.
+    template<typename T> class VPL_API AreaFiller
+    {
+    public:
+
+        AreaFiller(){}
+        ~AreaFiller(){}
+
+        void fill(PixelBuffer* target,
+                  ScanLineList* allEdges,
+                  T& blender,
+                  FillParameters& params,
+                  FillState* state,
+                  bool evenOdd)
+        {
+            // Scanlines to fill
+            int firstLine = allEdges->getMin();
+            int lastLine = allEdges->getMax();
+
+            if(lastLine > params.lastLine_)
+                lastLine = params.lastLine_;
+
+            if(firstLine > lastLine || params.firstLine_ > lastLine)
+                return;
+
+            ActiveEdgeList& activeEdges = state->activeEdges_;
+            AreaCoverageBuffer* coverageBuffer = &state->areaCoverageBuffer_;
+
+            activeEdges.clearList();
+
+            // Edges above the range are already active
+            if(firstLine < params.firstLine_)
+            {
+                activateEdges(allEdges,activeEdges,params);
+                firstLine = params.firstLine_;
+            }
+
+            // Horizontal span of scanline
+            HorizontalSpan xSpan;
+
+            // Room for the pixel to the right of the last one
+            coverageBuffer->initialize(target->getWidth() + 2);
+
+            float* cells = coverageBuffer->cells_;
+            int lastX = static_cast<int>(target->getWidth()) - 1;
+
+            // For traversing list
+            Edge* currentEdge = 0;
+
+            // We use premultiplied alpha
+            vplUint32 color = blender.getColor();
+
+            // Traverse scanlines
+            for(int y = firstLine; y <= lastLine; ++y)
+            {
+                int lineEnd = (y + 1) << params.subPixelShift_;
+
+                // Reset span
+                xSpan.reset();
+
+                // Handle active edges
+                for(vplUint i = 0; i < activeEdges.getCount();)
+                {
+                    currentEdge = activeEdges.getEdge(i);
+
+                    accumulateEdge(cells,currentEdge,lineEnd,params,xSpan);
+
+                    // Remove the edge on its last scanline,
+                    // the last edge takes its index
+                    if((currentEdge->lastScanLine_ >> params.subPixelShift_) == y)
+                        activeEdges.remove(i);
+                    else
+                        ++i;
+                }
+
+                // Get current scanline
+                const Edge* lineEdge = allEdges->getLine(y);
+                const Edge* lastEdge = allEdges->getLineEnd(y);
+
+                // Traverse edges in this scanline
+                for(; lineEdge != lastEdge; ++lineEdge)
+                {
+                    // If the edge only spans this scan line work on a
+                    // copy, the scanline list is left untouched
+                    if((lineEdge->lastScanLine_ >> params.subPixelShift_) == y)
+                    {
+                        Edge edge = *lineEdge;
+
+                        accumulateEdge(cells,&edge,lineEnd,params,xSpan);
+                    }
+                    // Edge stretches in to next scanline
+                    else
+                        accumulateEdge(cells,activeEdges.insert(*lineEdge),
+                                       lineEnd,params,xSpan);
+                }
+
+                int minX = xSpan.getMin();
+                int maxX = xSpan.getMax();
+
+                if(minX > maxX)
+                    continue;
+
+                // Pixels
+                vplUint32* pixels = target->getBuffer() + y * target->getWidth();
+
+                // Sum up the cells, pixels with full coverage are
+                // blended in runs
+                float winding = 0.0f;
+                int runStart = -1;
+                int x = minX;
+
+                for(; x <= maxX && x <= lastX; ++x)
+                {
+                    winding += cells[x];
+                    cells[x] = 0.0f;
+
+                    vplUint32 alpha = getAreaCoverage(winding,evenOdd);
+
+                    if(alpha >= 256)
+                    {
+                        if(runStart < 0)
+                            runStart = x;
+
+                        continue;
+                    }
+
+                    if(runStart >= 0)
+                    {
+                        blendRun(blender,pixels,runStart,y,x - runStart,params);
+                        runStart = -1;
+                    }
+
+                    // Partially covered pixel
+                    if(alpha > 0 && x >= params.firstColumn_ && x <= params.lastColumn_)
+                    {
+                        vplUint32 cs = multiplyPixel(color,alpha,8);
+                        vplUint32 ct = multiplyPixel(pixels[x],256 - alpha,8);
+
+                        pixels[x] = ct + cs;
+                    }
+                }
+
+                if(runStart >= 0)
+                    blendRun(blender,pixels,runStart,y,x - runStart,params);
+
+                // Clear what is right of the target
+                for(; x <= maxX; ++x)
+                    cells[x] = 0.0f;
+            }
+        }
+    };
+
     template<typename T> class VPL_API EvenOddFiller
     {
     public:
 
+        // Most partially filled pixels handled at once
+        static const vplUint cCoverageRun = 64;
+
         EvenOddFiller(){}
         ~EvenOddFiller(){}
 
@@ -81,12 +500,39 @@ namespace vpl
                   ScanLineList* allEdges,
                   T blender,
                   FillParameters& params,
-                  EvenOddMaskBuffer* evenOddMaskBuffer)
+                  FillState* state)
         {
-            ActiveEdgeList activeEdges;
+            if(params.areaCoverage_)
+            {
+                AreaFiller<T> filler;
+                filler.fill(target,allEdges,blender,params,state,true);
+                return;
+            }
+
+            // Scanlines to fill
+            int firstLine = allEdges->getMin();
+            int lastLine = allEdges->getMax();
+
+            if(lastLine > params.lastLine_)
+                lastLine = params.lastLine_;
+
+            if(firstLine > lastLine || params.firstLine_ > lastLine)
+                return;
+
+            ActiveEdgeList& activeEdges = state->activeEdges_;
+            EvenOddMaskBuffer* evenOddMaskBuffer = &state->evenOddMaskBuffer_;
 
-            // Choose super sampling mask
-            IEvenOddMaskGenerator& maskGen = chooseEvenOddMaskGen(params.subPixelCount_);
+            activeEdges.clearList();
+
+            // Edges above the range are already active
+            if(firstLine < params.firstLine_)
+            {
+                activateEdges(allEdges,activeEdges,params);
+                firstLine = params.firstLine_;
+            }
+
+            // Super sampling mask
+            IEvenOddMaskGenerator& maskGen = *state->evenOddMaskGen_;
 
             // Horizontal span of scanline
             HorizontalSpan xSpan;
@@ -102,27 +548,30 @@ namespace vpl
             // We use premultiplied alpha
             vplUint32 color = blender.getColor();
 
+            // Coverage of partially filled pixels
+            EvenOddCoverageKernel coverageKernel = getBlendKernels().evenOddCoverage_;
+            vplUint32 coverage[cCoverageRun];
+
             // Traverse scanlines
-            for(int y = allEdges->getMin(); y <= allEdges->getMax(); ++y)
+            for(int y = firstLine; y <= lastLine; ++y)
             {
                 // Reset span
                 xSpan.reset();
 
                 // Handle active edges
-                currentEdge = activeEdges.getList();
-
-                while(currentEdge)
+                for(vplUint i = 0; i < activeEdges.getCount();)
                 {
+                    currentEdge = activeEdges.getEdge(i);
+
                     // If this is the last scanline for this edge
                     if((currentEdge->lastScanLine_ >> params.subPixelShift_) == y )
                     {
                         // Generate mask for partial subpixel
                         maskGen.processEdgeOnLastScanline(currentEdge);
 
-                        // Remove the edge from the active edge table
-                        activeEdges.remove(currentEdge);
-
-                        currentEdge = currentEdge->nextEdge_;
+                        // Remove the edge from the active edge table,
+                        // the last edge takes its index
+                        activeEdges.remove(i);
                     }
                     else
                     {
@@ -130,35 +579,34 @@ namespace vpl
                         maskGen.processEdge(currentEdge);
 
                         // continue through edge table
-                        currentEdge = currentEdge->nextEdge_;
+                        ++i;
                     }
                 }
 
                 // Get current scanline
-                currentEdge = allEdges->getLine(y);
+                const Edge* lineEdge = allEdges->getLine(y);
+                const Edge* lastEdge = allEdges->getLineEnd(y);
 
                 // Traverse edges in this scanline
-                while(currentEdge)
+                for(; lineEdge != lastEdge; ++lineEdge)
                 {
                     // If the edge only spans this scan line
-                    if((currentEdge->lastScanLine_ >> params.subPixelShift_) == y)
+                    if((lineEdge->lastScanLine_ >> params.subPixelShift_) == y)
                     {
-                        // Generate mask for partial subpixel
-                        int subPixelEnd = currentEdge->lastScanLine_ & (params.subPixelCount_ - 1);
-
-                        maskGen.processEdgeOnFirstScanline(currentEdge,subPixelEnd);
+                        // Generate mask for partial subpixel on a copy,
+                        // the scanline list is left untouched
+                        Edge edge = *lineEdge;
+                        int subPixelEnd = lineEdge->lastScanLine_ & (params.subPixelCount_ - 1);
 
-                        // Update edge
-                        currentEdge = currentEdge->nextEdge_;
+                        maskGen.processEdgeOnFirstScanline(&edge,subPixelEnd);
                     }
                     // Edge stretches in to next scanline
                     else
                     {
-                        // Generate mask for partial subpixel
-                        maskGen.processEdgeOnFirstScanline(currentEdge,params.subPixelCount_);
-
-                        // add the edge to active edge table
-                        currentEdge = activeEdges.insertAndGetNext(currentEdge);
+                        // add the edge to active edge table and
+                        // generate mask for partial subpixel
+                        maskGen.processEdgeOnFirstScanline(activeEdges.insert(*lineEdge),
+                                                           params.subPixelCount_);
                     }
                 }
 
@@ -181,6 +629,10 @@ namespace vpl
                 // Pixels
                 vplUint32* pixels = target->getBuffer() + y * target->getWidth();
 
+                // Columns to fill
+                vplUint32* firstPixel = pixels + params.firstColumn_;
+                vplUint32* lastPixel = pixels + params.lastColumn_;
+
                 if(minX < maxX)
                 {
                     vplUint32* pixelPointer = pixels + minX;
@@ -227,30 +679,41 @@ namespace vpl
                             mask ^= temp;
 
                             // Blend
-                            blender.blend(pixelPointer,
-                                          pixelPointer - pixels,
-                                          y,count);
+                            blendRun(blender,pixels,
+                                     static_cast<int>(pixelPointer - pixels),
+                                     y,count,params);
                             pixelPointer += count;
                         }
 
-                        // Partially filled pixel
+                        // Partially filled pixels, coverage is computed
+                        // for the whole run first
                         else
                         {
-                            do
+                            vplUint count = static_cast<vplUint>(maskBufferEnd - maskBufferPointer) + 1;
+
+                            if(count > cCoverageRun)
+                                count = cCoverageRun;
+
+                            count = coverageKernel(maskBufferPointer,&mask,
+                                                   params.maxCoverage_,coverage,count);
+
+                            for(vplUint i = 0; i < count; i++)
                             {
                                 // alpha is in range of 0 to SUBPIXEL_COUNT
-                                vplUint32 alpha = getPixelCoverage(mask);
-                                vplUint32 invAlpha = params.subPixelCount_ - alpha;
-                                vplUint32 cs = multiplyPixel(color,alpha, params.subPixelShift_);
-                                vplUint32 ct = multiplyPixel(*pixelPointer,invAlpha,params.subPixelShift_);
+                                if(pixelPointer >= firstPixel && pixelPointer <= lastPixel)
+                                {
+                                    vplUint32 alpha = coverage[i];
+                                    vplUint32 invAlpha = params.subPixelCount_ - alpha;
+                                    vplUint32 cs = multiplyPixel(color,alpha, params.subPixelShift_);
+                                    vplUint32 ct = multiplyPixel(*pixelPointer,invAlpha,params.subPixelShift_);
 
-                                *pixelPointer++ = ct + cs;
+                                    *pixelPointer = ct + cs;
+                                }
 
-                                mask ^= *maskBufferPointer;
-                                *maskBufferPointer++ = 0;
+                                pixelPointer++;
                             }
-                            while(!(mask == 0 || mask == params.maxCoverage_) &&
-                                    (maskBufferPointer <= maskBufferEnd));
+
+                            maskBufferPointer += count;
                         }
                     }
                 }
@@ -268,12 +731,39 @@ namespace vpl
 
             void fill(PixelBuffer* target,ScanLineList* allEdges,
                       T blender,FillParameters& params,
-                      NonZeroMaskBuffer* nonZeroMaskBuffer)
+                      FillState* state)
             {
-                ActiveEdgeList activeEdges;
+                if(params.areaCoverage_)
+                {
+                    AreaFiller<T> filler;
+                    filler.fill(target,allEdges,blender,params,state,false);
+                    return;
+                }
+
+                // Scanlines to fill
+                int firstLine = allEdges->getMin();
+                int lastLine = allEdges->getMax();
+
+                if(lastLine > params.lastLine_)
+                    lastLine = params.lastLine_;
 
-                // Choose super sampling mask
-                INonZeroMaskGenerator& maskGen = chooseNonZeroMaskGen(params.subPixelCount_);
+                if(firstLine > lastLine || params.firstLine_ > lastLine)
+                    return;
+
+                ActiveEdgeList& activeEdges = state->activeEdges_;
+                NonZeroMaskBuffer* nonZeroMaskBuffer = &state->nonZeroMaskBuffer_;
+
+                activeEdges.clearList();
+
+                // Edges above the range are already active
+                if(firstLine < params.firstLine_)
+                {
+                    activateEdges(allEdges,activeEdges,params);
+                    firstLine = params.firstLine_;
+                }
+
+                // Super sampling mask
+                INonZeroMaskGenerator& maskGen = *state->nonZeroMaskGen_;
 
                 // Horizontal span of scanline
                 HorizontalSpan xSpan;
@@ -297,29 +787,25 @@ namespace vpl
                 vplUint32 color = blender.getColor();
 
                 // Traverse scanlines
-                for(int y = allEdges->getMin(); y <= allEdges->getMax(); ++y)
+                for(int y = firstLine; y <= lastLine; ++y)
                 {
                     // Reset span
                     xSpan.reset();
 
                     // Handle active edges
-                    currentEdge = activeEdges.getList();
-
-                    while(currentEdge)
+                    for(vplUint i = 0; i < activeEdges.getCount();)
                     {
+                        currentEdge = activeEdges.getEdge(i);
+
                         // If this is the last scanline for this edge
                         if((currentEdge->lastScanLine_ >> params.subPixelShift_) == y )
                         {
                             // Generate mask for partial pixel
                             maskGen.processEdgeOnLastScanline(currentEdge);
 
-                            // Remove the edge from the active edge table
-                            activeEdges.remove(currentEdge);
-
-							if(currentEdge != currentEdge->nextEdge_)
-								currentEdge = currentEdge->nextEdge_;
-							else
-								currentEdge = 0;
+                            // Remove the edge from the active edge table,
+                            // the last edge takes its index
+                            activeEdges.remove(i);
                         }
                         else
                         {
@@ -327,34 +813,34 @@ namespace vpl
                             maskGen.processEdge(currentEdge);
 
                             // continue through edge table
-                            currentEdge = currentEdge->nextEdge_;
+                            ++i;
                         }
                     }
 
                     // Get current scanline
-                    currentEdge = allEdges->getLine(y);
+                    const Edge* lineEdge = allEdges->getLine(y);
+                    const Edge* lastEdge = allEdges->getLineEnd(y);
 
                     // Traverse edges in this scanline
-                    while(currentEdge)
+                    for(; lineEdge != lastEdge; ++lineEdge)
                     {
                         // If the edge only spans this scan line
-                        if((currentEdge->lastScanLine_ >> params.subPixelShift_) == y)
+                        if((lineEdge->lastScanLine_ >> params.subPixelShift_) == y)
                         {
-                            // Generate mask for possibly partial pixel
-                            int subPixelEnd   = currentEdge->lastScanLine_ & (params.subPixelCount_ - 1);
+                            // Generate mask for possibly partial pixel on
+                            // a copy, the scanline list is left untouched
+                            Edge edge = *lineEdge;
+                            int subPixelEnd   = lineEdge->lastScanLine_ & (params.subPixelCount_ - 1);
 
-                            maskGen.processEdgeOnFirstScanline(currentEdge,subPixelEnd);
-
-                            currentEdge = currentEdge->nextEdge_;
+                            maskGen.processEdgeOnFirstScanline(&edge,subPixelEnd);
                         }
                         // Edge stretches in to next scanline
                         else
                         {
-                            // Generate mask for possibly partial pixel
-                            maskGen.processEdgeOnFirstScanline(currentEdge,params.subPixelCount_);
-
-                            // add the edge to active edge table
-                            currentEdge = activeEdges.insertAndGetNext(currentEdge);
+                            // add the edge to active edge table and
+                            // generate mask for possibly partial pixel
+                            maskGen.processEdgeOnFirstScanline(activeEdges.insert(*lineEdge),
+                                                               params.subPixelCount_);
                         }
                     }
 
@@ -379,10 +865,14 @@ namespace vpl
                     // Pixels
                     vplUint32* pixels = target->getBuffer() + y * target->getWidth();
 
+                    // Columns to fill
+                    vplUint32* firstPixel = pixels + params.firstColumn_;
+                    vplUint32* lastPixel = pixels + params.lastColumn_;
+
                     if(minX < maxX)
                     {
                         vplUint32* pixelPointer = pixels + minX;
-                        acc.reset((*nonZeroMaskBuffer)[index]);
+                        acc.reset(nonZeroMaskBuffer->getWindings(index));
 
                         while(index < maxX)
                         {
@@ -393,11 +883,11 @@ namespace vpl
 
                                 do
                                 {
-                                    (*nonZeroMaskBuffer)[index++].reset();
+                                    nonZeroMaskBuffer->reset(index++);
                                 }
-                                while((*nonZeroMaskBuffer)[index].readMask() == 0 && index < maxX);
+                                while(nonZeroMaskBuffer->getMask(index) == 0 && index < maxX);
 
-                                acc.initialize((*nonZeroMaskBuffer)[index]);
+                                acc.accumulate(nonZeroMaskBuffer->getWindings(index));
 
                                 // Increase bitmap pointer
                                 pixelPointer += (index - start);
@@ -412,18 +902,18 @@ namespace vpl
                                 {
                                     ++count;
 
-                                    (*nonZeroMaskBuffer)[index++].reset();
+                                    nonZeroMaskBuffer->reset(index++);
 
-                                    if((*nonZeroMaskBuffer)[index].readMask())
-                                        acc.accumulate((*nonZeroMaskBuffer)[index]);
+                                    if(nonZeroMaskBuffer->getMask(index))
+                                        acc.accumulate(nonZeroMaskBuffer->getWindings(index));
 
                                 }
                                 while(acc.readMask() == params.maxCoverage_ && index < maxX);
 
                                 // Blend
-                                blender.blend(pixelPointer,
-                                              pixelPointer - pixels,
-                                              y,count);
+                                blendRun(blender,pixels,
+                                         static_cast<int>(pixelPointer - pixels),
+                                         y,count,params);
 
                                 pixelPointer += count;
                             }
@@ -440,16 +930,21 @@ namespace vpl
 
                                 do
                                 {
-                                    vplUint32 cs = multiplyPixel(color,alpha,params.subPixelShift_);
-                                    vplUint32 ct = multiplyPixel(*pixelPointer,invAlpha,params.subPixelShift_);
+                                    if(pixelPointer >= firstPixel && pixelPointer <= lastPixel)
+                                    {
+                                        vplUint32 cs = multiplyPixel(color,alpha,params.subPixelShift_);
+                                        vplUint32 ct = multiplyPixel(*pixelPointer,invAlpha,params.subPixelShift_);
 
-                                    *pixelPointer++ = ct + cs;
+                                        *pixelPointer = ct + cs;
+                                    }
+
+                                    pixelPointer++;
 
-                                    (*nonZeroMaskBuffer)[index++].reset();
+                                    nonZeroMaskBuffer->reset(index++);
 
-                                    if((*nonZeroMaskBuffer)[index].readMask())
+                                    if(nonZeroMaskBuffer->getMask(index))
                                     {
-                                        acc.accumulate((*nonZeroMaskBuffer)[index]);
+                                        acc.accumulate(nonZeroMaskBuffer->getWindings(index));
                                         alpha = getPixelCoverage(acc.readMask());
                                         invAlpha = params.subPixelCount_ - alpha;
                                     }
@@ -460,32 +955,46 @@ namespace vpl
                                     index < maxX);
                             }
                         }
-                        (*nonZeroMaskBuffer)[index].reset();
+                        nonZeroMaskBuffer->reset(index);
                     }
                 }
             }
     };
 
+    // One fill of an edge list
+    struct FillJob
+    {
+        BlendMode blendMode_;
+        Brush::FillMode fillMode_;
+        vplUint32 color_;
+        const Gradient* gradient_;
+        ScanLineList* edges_;
+    };
+
     void composeBuffers(BlendMode blendMode,PixelBuffer* target,
                         const PixelBuffer& src,Rect rect);
 
+    // Choose correct fill function for job
+    void fillPath(const FillJob& job,PixelBuffer* target,
+                  FillParameters& params,FillState* state);
+
     void fillEvenOdd(BlendMode blendMode,PixelBuffer* target,
 					 ScanLineList* edges,vplUint32 color,FillParameters& params,
-                     EvenOddMaskBuffer* evenOddMaskBuffer);
+                     FillState* state);
 
     void gradientFillEvenOdd(BlendMode blendMode,PixelBuffer* target,
-						     ScanLineList* edges,Gradient* gradient,
+						     ScanLineList* edges,const Gradient* gradient,
 							 FillParameters& params,
-                             EvenOddMaskBuffer* evenOddMaskBuffer);
+                             FillState* state);
 
     void fillNonZero(BlendMode blendMode,PixelBuffer* target,
 		             ScanLineList* edges,vplUint32 color,FillParameters& params,
-                     NonZeroMaskBuffer* nonZeroMaskBuffer);
+                     FillState* state);
 
     void gradientFillNonZero(BlendMode blendMode,PixelBuffer* target,
-		                     ScanLineList* edges,Gradient* gradient,
+		                     ScanLineList* edges,const Gradient* gradient,
 							 FillParameters& params,
-                             NonZeroMaskBuffer* nonZeroMaskBuffer);
+                             FillState* state);
 
 }
 #endif
\ No newline at end of file
@@ -40,6 +40,11 @@ namespace vpl
             return FixedPoint(cFixedRaw,fixed_ - a.fixed_);
         }
         
+		inline FixedPoint operator *(int a) const
+        {
+            return FixedPoint(cFixedRaw,fixed_ * a);
+        }
+        
 		inline FixedPoint& operator +=(FixedPoint a) 
 		{ 
 			return *this = *this + a;
@@ -15,8 +15,12 @@
  * if not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cmath>
 #include "vplGradient.h"
+#include "vplBlendKernels.h"
 #include "vplColorHelper.h"
+#include "vplColorTableCache.h"
+#include "vplMemory.h"
 #include "vplVector.h"
 
 namespace vpl
@@ -26,52 +30,327 @@ namespace vpl
         return f >= 0.0f ? int(f + 0.5f) : int(f - int(f - 1) + 0.5f) + int(f - 1);
     }
 
-	static inline vplUint32 fetchGradientPixel(vplUint32* colorTable,
-                                               float pos,
-                                               Gradient::Spread spread)
+    // Color table index of a rounded position, one struct per spread.
+    // The table size is a power of two.
+    struct PadSpread
     {
-		int iPos = int(pos * (Gradient::cGradientColorTableSize - 1) + 0.5f);
-       
-        if(iPos < 0 || iPos >= Gradient::cGradientColorTableSize)
+        static inline int getIndex(int index,int size)
         {
+            index = index < 0 ? 0 : index;
+
+            return index > size - 1 ? size - 1 : index;
+        }
+    };
+
+    struct RepeatSpread
+    {
+        static inline int getIndex(int index,int size)
+        {
+            return index & (size - 1);
+        }
+    };
+
+    // Every other period is mirrored
+    struct ReflectSpread
+    {
+        static inline int getIndex(int index,int size)
+        {
+            int mirror = (index & size) ? -1 : 0;
+
+            return (index ^ mirror) & (size - 1);
+        }
+    };
+
+    // Colors of a gradient, a color table or two stops that are
+    // interpolated directly. Direct interpolation works like a table of
+    // size entries that is computed per pixel.
+    struct GradientColors
+    {
+        GradientColors(const vplUint32* table,int size,const Gradient::Stop* stops):
+            table_(table),size_(size),first_(0),last_(0),scale_(0.0f),offset_(0.0f)
+        {
+            if(table_)
+                return;
+
+            // Entry i is at offset i / (size - 1), the weight of the
+            // last stop goes from 0 to 255 between the two offsets
+            float diff = stops[1].offset_ - stops[0].offset_;
+
+            if(diff < 1.0e-6f)
+                diff = 1.0e-6f;
+
+            first_ = preMultiplyColorRGBA(stops[0].color_.getColorRGBA());
+            last_ = preMultiplyColorRGBA(stops[1].color_.getColorRGBA());
+            scale_ = 255.0f / ((size - 1) * diff);
+            offset_ = 0.5f - 255.0f * stops[0].offset_ / diff;
+        }
+
+        const vplUint32* table_;
+        int size_;
+        vplUint32 first_;
+        vplUint32 last_;
+        float scale_;
+        float offset_;
+    };
+
+    // Color of a table index, one struct per kind of colors
+    struct TableLookup
+    {
+        static inline vplUint32 getColor(const GradientColors& colors,int index)
+        {
+            return colors.table_[index];
+        }
+    };
+
+    struct DirectLookup
+    {
+        static inline vplUint32 getColor(const GradientColors& colors,int index)
+        {
+            float t = index * colors.scale_ + colors.offset_;
+            int dist = t <= 0.0f ? 0 : (t >= 255.0f ? 255 : static_cast<int>(t));
+
+            return interpolatePixel(colors.first_,255 - dist,colors.last_,dist);
+        }
+    };
+
+    static inline vplUint32 getColor(const GradientColors& colors,int index)
+    {
+        if(colors.table_)
+            return TableLookup::getColor(colors,index);
+        else
+            return DirectLookup::getColor(colors,index);
+    }
+
+    // Table of its own indices. With it the kernels write the indices
+    // of direct interpolation, which are then turned into colors.
+    struct IndexTable
+    {
+        IndexTable()
+        {
+            for(int i = 0; i < Gradient::cSmallColorTableSize; i++)
+                indices_[i] = i;
+        }
+
+        vplUint32 indices_[Gradient::cSmallColorTableSize];
+    };
+
+    static const IndexTable indexTable;
+
+    static inline const vplUint32* getKernelTable(const GradientColors& colors)
+    {
+        return colors.table_ ? colors.table_ : indexTable.indices_;
+    }
+
+    static void lookupDirect(vplUint32* dest,const GradientColors& colors,
+                             vplUint count)
+    {
+        for(vplUint i = 0; i < count; i++)
+            dest[i] = DirectLookup::getColor(colors,static_cast<int>(dest[i]));
+    }
+
+    template<class S,class L> static void fetchLinearPixels(vplUint32* dest,
+                                                            const GradientColors& colors,
+                                                            vplUint32 position,
+                                                            vplUint32 increment,
+                                                            vplUint begin,
+                                                            vplUint length)
+    {
+        position += increment * begin;
+
+        for(vplUint i = begin; i < length; i++)
+        {
+            dest[i] = L::getColor(colors,S::getIndex(static_cast<int>(position) >> 16,
+                                                     colors.size_));
+            position += increment;
+        }
+    }
+
+    // Step through the color table with a 16.16 fixed point position,
+    // whole vectors are done by the kernel
+    template<class S> static void fetchLinearSpan(vplUint32* dest,
+                                                  const GradientColors& colors,
+                                                  Gradient::Spread spread,
+                                                  vplUint32 position,
+                                                  vplUint32 increment,
+                                                  vplUint length)
+    {
+        GradientSpanKernel kernel = getBlendKernels().linearGradient_[spread];
+
+        vplUint done = kernel(dest,getKernelTable(colors),colors.size_,
+                              position,increment,length);
+
+        if(colors.table_)
+            fetchLinearPixels<S,TableLookup>(dest,colors,position,increment,done,length);
+        else
+        {
+            lookupDirect(dest,colors,done);
+            fetchLinearPixels<S,DirectLookup>(dest,colors,position,increment,done,length);
+        }
+    }
+
+    // Linear gradient span with the position in color table units.
+    // Repeat and reflect wrap around a power of two period, so the fixed
+    // point position may overflow and wrap with it.
+    static void fetchLinearGradient(vplUint32* dest,const GradientColors& colors,
+                                    Gradient::Spread spread,float pos,float inc,
+                                    vplUint length)
+    {
+        const float size = static_cast<float>(colors.size_);
+        const float fixedOne = 65536.0f;
+
+        if(spread != Gradient::cPad)
+        {
+            float period = spread == Gradient::cReflect ? 2.0f * size : size;
+
+            // Round to nearest entry and move in to the first period
+            pos += 0.5f;
+            pos -= std::floor(pos / period) * period;
+            inc -= std::floor(inc / period) * period;
+
+            vplUint32 position = static_cast<vplUint32>(pos * fixedOne);
+            vplUint32 increment = static_cast<vplUint32>(inc * fixedOne);
+
             if(spread == Gradient::cReflect)
-            { 
-                const int limit = Gradient::cGradientColorTableSize * 2 - 1;
-                iPos = iPos % limit;
-                iPos = iPos < 0 ? limit + iPos : iPos;
-                iPos = iPos >= Gradient::cGradientColorTableSize ? limit - iPos : iPos;
-            }
-            else if(spread == Gradient::cRepeat)
-            {
-                iPos = iPos % Gradient::cGradientColorTableSize;
-                iPos = iPos < 0 ? Gradient::cGradientColorTableSize + iPos : iPos;   
-            }
+                fetchLinearSpan<ReflectSpread>(dest,colors,spread,position,increment,length);
+            else
+                fetchLinearSpan<RepeatSpread>(dest,colors,spread,position,increment,length);
+
+            return;
+        }
+
+        // Pad, the pixels that are outside of the table on either side get
+        // the end colors. One entry of margin covers rounding.
+        const float low = -1.0f;
+        const float high = size;
+        const float count = static_cast<float>(length);
+
+        vplUint begin = 0;
+        vplUint end = length;
+
+        if(inc != 0.0f)
+        {
+            float enter = ((inc > 0.0f ? low : high) - pos) / inc;
+            float leave = ((inc > 0.0f ? high : low) - pos) / inc;
+
+            if(enter > 0.0f)
+                begin = enter < count ? static_cast<vplUint>(std::ceil(enter)) : length;
+
+            if(leave < count)
+                end = leave < 0.0f ? 0 : static_cast<vplUint>(std::floor(leave)) + 1;
+
+            if(begin > length)
+                begin = length;
+
+            if(end < begin)
+                end = begin;
+
+            // The inner part is at most a pixel when the increment is
+            // larger than the table, keep it in range
+            if(inc > high)
+                inc = high;
+            else if(inc < -high)
+                inc = -high;
+        }
+        else if(pos < low || pos > high)
+            begin = end = length;
+
+        vplUint32 lowColor = getColor(colors,0);
+        vplUint32 highColor = getColor(colors,colors.size_ - 1);
+        vplUint32 first = inc > 0.0f || (inc == 0.0f && pos < low) ? lowColor : highColor;
+        vplUint32 last = inc < 0.0f ? lowColor : highColor;
+
+        vplMemFill32(dest,first,begin);
+        vplMemFill32(dest + end,last,length - end);
+
+        if(begin < end)
+        {
+            float start = pos + inc * begin + 0.5f;
+            vplUint32 position = static_cast<vplUint32>(static_cast<int>(std::floor(start * fixedOne)));
+            vplUint32 increment = static_cast<vplUint32>(static_cast<int>(inc * fixedOne));
+
+            fetchLinearSpan<PadSpread>(dest + begin,colors,spread,position,increment,end - begin);
+        }
+    }
+
+    // Radial gradient span, see RadialGradientSpan. Whole vectors are done
+    // by the kernel, which does the same float operations.
+    template<class S,class L,bool centered> static void fetchRadialSpan(vplUint32* dest,
+                                                                        const GradientColors& colors,
+                                                                        const RadialGradientSpan& span,
+                                                                        vplUint begin,
+                                                                        vplUint length)
+    {
+        for(vplUint i = begin; i < length; i++)
+        {
+            float x = span.x_ + static_cast<float>(i);
+            float d = span.k_ * (x * x + span.a_);
+            float pos;
+
+            if(centered)
+                pos = std::sqrt(d) * span.scale_ + 0.5f;
             else
             {
-                if(iPos < 0)
-                    iPos = 0;
-                else if(iPos >= Gradient::cGradientColorTableSize)
-                    iPos = Gradient::cGradientColorTableSize - 1;
+                float b = span.bx_ * x + span.by_;
+
+                pos = (b + std::sqrt(b * b + d)) * span.scale_ + 0.5f;
             }
+
+            if(pos > cMaxGradientPosition)
+                pos = cMaxGradientPosition;
+
+            dest[i] = L::getColor(colors,S::getIndex(static_cast<int>(pos),colors.size_));
         }
-        
-        return colorTable[iPos];
     }
-    
-    static void generateGradientColorTable(vplUint32* colorTable,
-                                           Gradient::Stop* stops,
-                                           vplUint stopCount)
+
+    template<class S,class L> static void fetchRadialPixels(vplUint32* dest,
+                                                            const GradientColors& colors,
+                                                            const RadialGradientSpan& span,
+                                                            vplUint begin,
+                                                            vplUint length)
+    {
+        if(span.centered_)
+            fetchRadialSpan<S,L,true>(dest,colors,span,begin,length);
+        else
+            fetchRadialSpan<S,L,false>(dest,colors,span,begin,length);
+    }
+
+    template<class S> static void fetchRadialGradient(vplUint32* dest,
+                                                      const GradientColors& colors,
+                                                      Gradient::Spread spread,
+                                                      const RadialGradientSpan& span,
+                                                      vplUint length)
     {
-        // Input validation
+        RadialGradientKernel kernel = getBlendKernels().radialGradient_[spread];
+
+        vplUint done = kernel(dest,getKernelTable(colors),colors.size_,span,length);
+
+        if(colors.table_)
+            fetchRadialPixels<S,TableLookup>(dest,colors,span,done,length);
+        else
+        {
+            lookupDirect(dest,colors,done);
+            fetchRadialPixels<S,DirectLookup>(dest,colors,span,done,length);
+        }
+    }
+
+    void generateGradientColorTable(vplUint32* colorTable,int size,
+                                    const Gradient::Stop* stops,
+                                    vplUint stopCount)
+    {
+        // Input validation, no stops is transparent
         if(stopCount == 0)
+        {
+            vplMemFill32(colorTable,0,size);
+
 			return;
+        }
       
         vplUint32 color = preMultiplyColorRGBA(stops[0].color_.getColorRGBA());
         
         // Easy case when we only have one stop
         if(stopCount == 1)
         {
-            for(int i = 0; i < Gradient::cGradientColorTableSize;i++)
+            for(int i = 0; i < size;i++)
                 colorTable[i] = color;
             
             return;
@@ -82,7 +361,7 @@ namespace vpl
         vplUint currStop = 0;
         float startPos = stops[0].offset_;
         float endPos = stops[stopCount - 1].offset_;
-        float increment = 1.0f/Gradient::cGradientColorTableSize;
+        float increment = 1.0f/size;
         float currPos = increment * 1.5f;
         
         // Fill table up to first stop
@@ -154,25 +433,115 @@ namespace vpl
         // After last point
         color = preMultiplyColorRGBA(stops[stopCount - 1].color_.getColorRGBA());
         
-        while (ctIndex < Gradient::cGradientColorTableSize - 1)
+        while (ctIndex < static_cast<vplUint>(size - 1))
             colorTable[ctIndex++] = color;
         
         // Make sure the last color stop is represented at the end of the table
-        colorTable[Gradient::cGradientColorTableSize - 1] = color;
+        colorTable[size - 1] = color;
+    }
+
+    // Largest difference of a channel between two colors
+    static int getChannelDifference(vplUint32 color1,vplUint32 color2)
+    {
+        int difference = 0;
+
+        for(int shift = 0; shift < 32; shift += 8)
+        {
+            int c1 = (color1 >> shift) & 0xff;
+            int c2 = (color2 >> shift) & 0xff;
+            int d = c1 > c2 ? c1 - c2 : c2 - c1;
+
+            if(d > difference)
+                difference = d;
+        }
+
+        return difference;
+    }
+
+    // Enough entries for neighbours to differ by at most one color level,
+    // but no more than four per pixel along the gradient. Finer than a
+    // pixel keeps the steps small where the gradient changes slowly
+    // across the screen.
+    static int chooseColorTableSize(float length,const Gradient::Stop* stops,
+                                    vplUint stopCount,Gradient::ColorLookup lookup)
+    {
+        float needed = 0.0f;
+
+        for(vplUint i = 1; i < stopCount; i++)
+        {
+            float spacing = stops[i].offset_ - stops[i - 1].offset_;
+            int difference = getChannelDifference(stops[i].color_.getColorRGBA(),
+                                                  stops[i - 1].color_.getColorRGBA());
+
+            if(spacing > 0.0f && difference / spacing > needed)
+                needed = difference / spacing;
+        }
+
+        if(needed > 4.0f * length)
+            needed = 4.0f * length;
+
+        int maxSize = Gradient::cMaxColorTableSize;
+
+        if(lookup == Gradient::cSmallTable)
+            maxSize = Gradient::cSmallColorTableSize;
+
+        int size = Gradient::cMinColorTableSize;
+
+        while(size < needed && size < maxSize)
+            size <<= 1;
+
+        return size;
     }
 
+	// Held while a gradient changes its table, renderers on different
+	// threads can draw the same gradient. Created at load time and never
+	// destroyed, like the color table cache
+	static Mutex* const gradientMutex = new Mutex;
+
 	void Gradient::generateGradient()
 	{
-		if(!colorTable_)
-			colorTable_ = new vplUint32[cGradientColorTableSize];
-		
-	    generateGradientColorTable(colorTable_,
-			                       stops_.getContents(),
-								   stops_.getItemCount());
+		MutexLocker locker(*gradientMutex);
+
+		updateColorTable();
+	}
+
+	void Gradient::validate()
+	{
+		MutexLocker locker(*gradientMutex);
+
+		if(!valid_)
+			updateColorTable();
+	}
+
+	void Gradient::updateColorTable()
+	{
+		ColorTableCache& cache = getColorTableCache();
+		ColorTable* table = 0;
+		vplUint stopCount = stops_.getItemCount();
 
+		if(lookup_ == cDirect && stopCount == 2)
+			colorTableSize_ = cSmallColorTableSize;
+		else
+		{
+			colorTableSize_ = chooseColorTableSize(getLength(),stops_.getContents(),
+			                                       stopCount,lookup_);
+
+			// Acquire before release, the table is kept if nothing changed
+			table = cache.acquire(stops_.getContents(),stopCount,colorTableSize_);
+		}
+
+		cache.release(sharedTable_);
+
+		sharedTable_ = table;
+		colorTable_ = table ? table->colors_ : 0;
 		valid_ = true;
 	}
 
+	Gradient::~Gradient()
+	{
+		getColorTableCache().release(sharedTable_);
+	}
+
 	LinearGradient::LinearGradient(float x,float y,float dirX,float dirY)
 	{
 		type_ = cLinear;
@@ -191,11 +560,14 @@ namespace vpl
 		}
 	}
 
-	vplUint32* LinearGradient::fetchGradient(vplUint x,vplUint y,vplUint length)
-    {
-		if(!valid_)
-			generateGradient();
+	float LinearGradient::getLength() const
+	{
+		return length_;
+	}
 
+	void LinearGradient::fetchGradient(vplUint32* dest,vplUint x,vplUint y,
+                                       vplUint length) const
+    {
         float xPos = x + 0.5f;
         float yPos = y + 0.5f;
         float inc = (deltaX_ + deltaY_) / length_;     
@@ -203,22 +575,16 @@ namespace vpl
         
         pos /= length_;
         
-		if(!gradientPixels_)
-			gradientPixels_ = new vplUint32[cMaxGradientPixels];
-
-        vplUint32* dest = gradientPixels_;
-        vplUint32* end  = dest + length;
-        
         if( length_ == 0.0f)
             pos = inc = 0.0f;
-        
-        while(dest < end)
-        { 
-            *dest++ = fetchGradientPixel(colorTable_,pos,spread_);
-            pos += inc;
-        } 
 
-		return gradientPixels_;
+        GradientColors colors(colorTable_,colorTableSize_,stops_.getContents());
+
+        // In color table units
+        const float scale = static_cast<float>(colorTableSize_ - 1);
+
+        fetchLinearGradient(dest,colors,spread_,
+                            pos * scale,inc * scale,length);
     }
 
 	RadialGradient::RadialGradient(float cx,float cy,float fx,float fy,float radius)
@@ -245,6 +611,19 @@ namespace vpl
             
         float r2 = radius * radius;			
 		c_ = computeDotProduct(focalPoint - centre,focalPoint - centre) - r2;
+
+        focalX_ = focalPoint.x_;
+        focalY_ = focalPoint.y_;
+        centered_ = focalPoint.x_ == centre.x_ && focalPoint.y_ == centre.y_;
+	}
+
+	// Longest distance from the focal point to the circle
+	float RadialGradient::getLength() const
+	{
+		float ex = focalX_ - data_.RadialGradientData.cx_;
+		float ey = focalY_ - data_.RadialGradientData.cy_;
+
+		return data_.RadialGradientData.radius_ + std::sqrt(ex * ex + ey * ey);
 	}
 
 	// Intersection of a ray and a circle. Parametrize the ray as
@@ -252,43 +631,46 @@ namespace vpl
 	// computeDotProduct(i-c,i-c) = radius^2
 	// computeDotProduct((f-c) + (p-f)*t, (f-c) + (p-f)*t) = radius^2
 	// computeDotProduct(p-f,p-f)*t^2 + 2*dot_product(f-c,p-f)*t + dot_product(f-c,f-c) - radius^2 = 0
-	// This gives the follwing pseudo code
-	// float a = Vector2.Dot(currentPoint - focus, currentPoint - focus);
-	// float b = 2 * Vector2.Dot(focus-centre, currentPoint-focus);
-	// float c = Vector2.Dot(focus-centre, focus-centre)- (radius * radius);
-    // float t = (-b + (float)Math.Sqrt((b*b) - 4*a*c)) / (2*a);
-	// float lerp = 1/t;
-	vplUint32* RadialGradient::fetchGradient(vplUint x,vplUint y,vplUint length)
+	// With a = computeDotProduct(p-f,p-f), b = 2*computeDotProduct(f-c,p-f)
+	// and c = computeDotProduct(f-c,f-c) - radius^2 the position in the
+	// gradient is 1/t = (b + sqrt(b*b - 4*a*c)) / (-2*c). c is negative
+	// with the focal point inside the circle, so there is no division per
+	// pixel. Along a span only the x of p-f changes.
+	void RadialGradient::fetchGradient(vplUint32* dest,vplUint x,vplUint y,
+                                       vplUint length) const
 	{
-		if(!valid_)
-			generateGradient();
-
-		Vector focalPoint(data_.RadialGradientData.fx_,data_.RadialGradientData.fy_);                          		
-		Vector centre(data_.RadialGradientData.cx_,data_.RadialGradientData.cy_);        
-		Vector currentPoint(x + 0.5f,y + 0.5f);        
-		Vector inc(1.0f,0.0f);                          
-		
-		if(!gradientPixels_)
-			gradientPixels_ = new vplUint32[cMaxGradientPixels];
-
-		vplUint32* dest = gradientPixels_;        
-		vplUint32* end  = dest + length;        	    
-		
-		while(dest < end)        
-		{             
-			float a = computeDotProduct(currentPoint - focalPoint,                                        
-				                        currentPoint - focalPoint);
-
-			float b = 2 * computeDotProduct(focalPoint - centre,                                            
-				                            currentPoint - focalPoint);
-
-			float pos = 1.0f / ((-b + sqrtf((b*b) - 4*a*c_)) / (2*a));			
-			
-			*dest++ = fetchGradientPixel(colorTable_,pos,spread_);           
-			
-			currentPoint += inc;        
-		}
+        float dy = y + 0.5f - focalY_;
+        float ex = focalX_ - data_.RadialGradientData.cx_;
+        float ey = focalY_ - data_.RadialGradientData.cy_;
+
+        GradientColors colors(colorTable_,colorTableSize_,stops_.getContents());
+        RadialGradientSpan span;
 
-		return gradientPixels_;
+        span.x_ = x + 0.5f - focalX_;
+        span.a_ = dy * dy;
+        span.bx_ = 2.0f * ex;
+        span.by_ = 2.0f * ey * dy;
+        span.k_ = -4.0f * c_;
+        span.scale_ = (colorTableSize_ - 1) / (-2.0f * c_);
+        span.centered_ = centered_;
+
+        switch(spread_)
+        {
+            case cReflect:
+                fetchRadialGradient<ReflectSpread>(dest,colors,
+                                                   spread_,span,length);
+                break;
+
+            case cRepeat:
+                fetchRadialGradient<RepeatSpread>(dest,colors,
+                                                  spread_,span,length);
+                break;
+
+            case cPad:
+            default:
+                fetchRadialGradient<PadSpread>(dest,colors,
+                                               spread_,span,length);
+                break;
+        }
 	}
 }
\ No newline at end of file
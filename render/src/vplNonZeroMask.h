@@ -23,108 +23,77 @@
 
 namespace vpl
 {
+    // Winding counts are signed bytes, packed eight to a word so
+    // they can be added and tested a word at a time
+    static const vplUint cWindingsPerWord = 8;
+    static const vplUint cMaxWindingWords = 32/cWindingsPerWord;
+
+    // Add packed windings without carry between them
+    inline vplUint64 addWindings(vplUint64 a,vplUint64 b)
+    {
+        const vplUint64 cLow = 0x7f7f7f7f7f7f7f7fULL;
+
+        return ((a & cLow) + (b & cLow)) ^ ((a ^ b) & ~cLow);
+    }
+
+    // Return a bit for every non zero winding
+    inline vplUint32 getNonZeroBits(vplUint64 a)
+    {
+        const vplUint64 cLow = 0x7f7f7f7f7f7f7f7fULL;
+
+        // High bit of every non zero byte
+        vplUint64 nonZero = (((a & cLow) + cLow) | a) & ~cLow;
+
+        // Gather the high bits in the top byte
+        return static_cast<vplUint32>((nonZero * 0x0002040810204081ULL) >> 56);
+    }
+
+    // Running winding counts along a scanline
     class NonZeroMask
     {
     public:
 
-        NonZeroMask():mask_(0),subPixelBuffer_(0),subPixelCount_(0){}
-
-        ~NonZeroMask()
+        NonZeroMask():mask_(0),words_(0)
         {
-            if(subPixelBuffer_)
-            {
-                delete [] subPixelBuffer_;
-                subPixelBuffer_ = 0;
-            }
+            memset(windings_,0x0,sizeof(windings_));
         }
 
+        ~NonZeroMask(){}
+
         // Initialization
         void initializeSubPixelBuffer(vplUint subPixelCount)
         {
-            if(subPixelBuffer_)
-                delete [] subPixelBuffer_;
-
-            subPixelBuffer_ = new char[subPixelCount];
-            memset(subPixelBuffer_,0x0,sizeof(char)*subPixelCount);
-            subPixelCount_ = subPixelCount;
+            memset(windings_,0x0,sizeof(windings_));
+            mask_ = 0;
+            words_ = subPixelCount/cWindingsPerWord;
         }
 
         // Accessors
-        inline vplUint32& getMask()       { return mask_;}
         inline vplUint32 readMask() const { return mask_;}
-        inline char& operator[](int i) const
-        {
-            return subPixelBuffer_[i];
-        }
 
-        // Clear mask
-        inline void reset()
+        // Set to windings of first pixel
+        inline NonZeroMask& reset(const vplUint64* windings)
         {
-            for(vplUint i = 0; i < subPixelCount_;i++)
-                subPixelBuffer_[i] = 0;
-
-            mask_ = 0;
-        }
-        // Set to first value in maskbuffer
-        inline NonZeroMask& reset(const NonZeroMask &rhs)
-        {
-            vplUint32 bit = 0x1;
             mask_ = 0;
 
-            for(vplUint i = 0; i < subPixelCount_;i++)
+            for(vplUint i = 0; i < words_; i++)
             {
-                if(rhs.mask_ & bit)
-                {
-                    subPixelBuffer_[i] = rhs.subPixelBuffer_[i];
-
-                    if(subPixelBuffer_[i])
-                        mask_ |= bit;
-                }
-
-                bit <<= 1;
+                windings_[i] = windings[i];
+                mask_ |= getNonZeroBits(windings_[i]) << (i*cWindingsPerWord);
             }
 
             return *this;
         }
-        // After an "on" span initialize with next mask
-        inline NonZeroMask& initialize(const NonZeroMask &rhs)
-        {
-            vplUint32 bit = 0x1;
-
-            for(vplUint i = 0; i < subPixelCount_;i++)
-            {
-                if(rhs.mask_ & bit)
-                {
-                    subPixelBuffer_[i] = rhs.subPixelBuffer_[i];
-
-                    if(subPixelBuffer_[i])
-                        mask_ |= bit;
-                }
-                bit <<= 1;
-            }
 
-            return *this;
-        }
-        // Add masks
-        inline NonZeroMask& accumulate(const NonZeroMask &rhs)
+        // Add windings of next pixel
+        inline NonZeroMask& accumulate(const vplUint64* windings)
         {
-            vplUint32 bit = 0x1;
-            char temp;
+            mask_ = 0;
 
-            for(vplUint i = 0; i < subPixelCount_;i++)
+            for(vplUint i = 0; i < words_; i++)
             {
-                // If bit is set, add winding
-                if(rhs.mask_ & bit)
-                {
-                    temp = subPixelBuffer_[i];
-                    subPixelBuffer_[i] += rhs.subPixelBuffer_[i];
-
-                    // If winding changed, toggle bit
-                    if((temp == 0) ^ (subPixelBuffer_[i] == 0))
-                        mask_ ^= bit;
-                }
-
-                bit <<= 1;
+                windings_[i] = addWindings(windings_[i],windings[i]);
+                mask_ |= getNonZeroBits(windings_[i]) << (i*cWindingsPerWord);
             }
 
             return *this;
@@ -132,53 +101,86 @@ namespace vpl
 
     private:
 
+        vplUint64 windings_[cMaxWindingWords];
         vplUint32 mask_;
-        char* subPixelBuffer_;
-        vplUint subPixelCount_;
+        vplUint words_;
 	};
 
+    // Winding counts for every pixel of a scanline stored as one plane,
+    // with a mask per pixel telling which subpixels that were touched
 	class VPL_API NonZeroMaskBuffer
 	{
     public:
 
-        NonZeroMaskBuffer():buffer_(0),size_(0){}
+        NonZeroMaskBuffer():windings_(0),masks_(0),size_(0),words_(0){}
         ~NonZeroMaskBuffer()
         {
-            if(buffer_)
-                delete [] buffer_;
+            delete [] windings_;
+            delete [] masks_;
         }
 
-        // Initialization
+        // Only allocate new space if needed, the buffer is left
+        // cleared by the fill
         inline void initialize(vplUint size,vplUint subPixelCount)
         {
+            vplUint words = subPixelCount/cWindingsPerWord;
 
             size += 1;
 
-            if(size > size_)
+            if(size > size_ || words != words_)
             {
-                delete [] buffer_;
+                if(size < size_)
+                    size = size_;
+
+                delete [] windings_;
+                delete [] masks_;
+
+                windings_ = new vplUint64[size*words];
+                masks_ = new vplUint32[size];
 
-                buffer_ = new NonZeroMask[size];
+                memset(windings_,0x0,sizeof(vplUint64)*size*words);
+                memset(masks_,0x0,sizeof(vplUint32)*size);
 
                 size_ = size;
+                words_ = words;
             }
+        }
+
+        // Accessors
+        inline vplUint32& getMask(int i) const
+        {
+            return masks_[i];
+        }
 
-            for(vplUint i = 0; i < size_;i++)
-                buffer_[i].initializeSubPixelBuffer(subPixelCount);
+        inline const vplUint64* getWindings(int i) const
+        {
+            return windings_ + i*words_;
+        }
 
+        // Winding of a subpixel
+        inline char& getWinding(int i,int subPixel) const
+        {
+            return reinterpret_cast<char*>(windings_ + i*words_)[subPixel];
         }
 
-        // Accessor
-        inline NonZeroMask& operator[](int i) const
+        // Clear pixel
+        inline void reset(int i)
         {
-            return buffer_[i];
+            vplUint64* windings = windings_ + i*words_;
+
+            for(vplUint j = 0; j < words_; j++)
+                windings[j] = 0;
+
+            masks_[i] = 0;
         }
 
     private:
 
-        NonZeroMask* buffer_;
+        vplUint64* windings_;
+        vplUint32* masks_;
         vplUint size_;
+        vplUint words_;
 
 	};
 }
-#endif
\ No newline at end of file
+#endif
@@ -56,8 +56,8 @@ namespace vpl
         for(int i = subPixelStart; i < subPixelEnd; ++i)
         {
             offsetIndex = (x + offsets_[i]).toInt();
-            (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-            (*maskBuffer_)[offsetIndex][i] += winding;
+            maskBuffer_->getMask(offsetIndex) |= dataMask;
+            maskBuffer_->getWinding(offsetIndex,i) += winding;
             dataMask <<= 1;
             x += slope;
         }
@@ -84,8 +84,8 @@ namespace vpl
         for(int i = 0; i < subPixelEnd; ++i)
         {
             offsetIndex = (x + offsets_[i]).toInt();
-            (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-            (*maskBuffer_)[offsetIndex][i] += winding;
+            maskBuffer_->getMask(offsetIndex) |= dataMask;
+            maskBuffer_->getWinding(offsetIndex,i) += winding;
             dataMask <<= 1;
             x += slope;
         }
@@ -107,50 +107,50 @@ namespace vpl
         int offsetIndex;
       
         offsetIndex = (x + SAMPLEMASK8x8[0]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][0] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,0) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK8x8[1]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][1] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,1) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK8x8[2]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][2] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,2) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK8x8[3]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][3] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,3) += winding;
         dataMask <<= 1;
         x += slope;
 
          offsetIndex = (x + SAMPLEMASK8x8[4]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][4] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,4) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK8x8[5]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][5] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,5) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK8x8[6]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][6] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,6) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK8x8[7]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][7] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,7) += winding;
         dataMask <<= 1;
         x += slope;
 
@@ -175,98 +175,98 @@ namespace vpl
 
       
         offsetIndex = (x + SAMPLEMASK16x16[0]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][0] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,0) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[1]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][1] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,1) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[2]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][2] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,2) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[3]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][3] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,3) += winding;
         dataMask <<= 1;
         x += slope;
 
          offsetIndex = (x + SAMPLEMASK16x16[4]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][4] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,4) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[5]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][5] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,5) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[6]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][6] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,6) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[7]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][7] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,7) += winding;
         dataMask <<= 1;
         x += slope;
 
         offsetIndex = (x + SAMPLEMASK16x16[8]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][8] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,8) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[9]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][9] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,9) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[10]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][10] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,10) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[11]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][11] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,11) += winding;
         dataMask <<= 1;
         x += slope;
 
          offsetIndex = (x + SAMPLEMASK16x16[12]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][12] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,12) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[13]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][13] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,13) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[14]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][14] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,14) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK16x16[15]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][15] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,15) += winding;
         dataMask <<= 1;
         x += slope;
 
@@ -291,194 +291,194 @@ namespace vpl
 
       
         offsetIndex = (x + SAMPLEMASK32x32[0]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][0] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,0) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[1]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][1] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,1) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[2]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][2] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,2) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[3]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][3] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,3) += winding;
         dataMask <<= 1;
         x += slope;
 
          offsetIndex = (x + SAMPLEMASK32x32[4]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][4] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,4) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[5]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][5] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,5) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[6]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][6] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,6) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[7]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][7] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,7) += winding;
         dataMask <<= 1;
         x += slope;
 
         offsetIndex = (x + SAMPLEMASK32x32[8]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][8] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,8) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[9]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][9] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,9) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[10]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][10] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,10) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[11]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][11] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,11) += winding;
         dataMask <<= 1;
         x += slope;
 
          offsetIndex = (x + SAMPLEMASK32x32[12]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][12] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,12) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[13]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][13] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,13) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[14]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][14] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,14) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[15]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][15] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,15) += winding;
         dataMask <<= 1;
         x += slope;
 
          offsetIndex = (x + SAMPLEMASK32x32[16]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][16] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,16) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[17]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][17] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,17) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[18]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][18] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,18) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[19]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][19] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,19) += winding;
         dataMask <<= 1;
         x += slope;
 
          offsetIndex = (x + SAMPLEMASK32x32[20]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][20] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,20) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[21]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][21] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,21) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[22]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][22] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,22) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[23]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][23] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,23) += winding;
         dataMask <<= 1;
         x += slope;
 
         offsetIndex = (x + SAMPLEMASK32x32[24]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][24] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,24) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[25]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][25] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,25) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[26]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][26] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,26) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[27]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][27] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,27) += winding;
         dataMask <<= 1;
         x += slope;
 
          offsetIndex = (x + SAMPLEMASK32x32[28]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][28] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,28) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[29]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][29] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,29) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[30]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][30] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,30) += winding;
         dataMask <<= 1;
         x += slope;
         
         offsetIndex = (x + SAMPLEMASK32x32[31]).toInt();
-        (*maskBuffer_)[offsetIndex].getMask() |= dataMask;
-        (*maskBuffer_)[offsetIndex][31] += winding;
+        maskBuffer_->getMask(offsetIndex) |= dataMask;
+        maskBuffer_->getWinding(offsetIndex,31) += winding;
         dataMask <<= 1;
         x += slope;
 
@@ -491,29 +491,4 @@ namespace vpl
         // Update the edge
         edge->x_ = x;
     }
-
-    INonZeroMaskGenerator& chooseNonZeroMaskGen(vplUint subPixelCount)
-    {
-        switch(subPixelCount)
-        {
-            case 32:
-			{
-                static NonZeroMaskGenerator32 nzm32;
-                return nzm32;
-			}
-            
-			case 16:
-			{
-                static NonZeroMaskGenerator16 nzm16;
-                return nzm16;
-			}
-
-            case 8:
-            default:
-			{
-                static NonZeroMaskGenerator8 nzm8;
-                return nzm8;
-			}
-        }
-    }
 }
@@ -80,8 +80,6 @@ namespace vpl
 
         void processEdge(Edge* edge);
 	};
-
-    INonZeroMaskGenerator& chooseNonZeroMaskGen(vplUint subPixelCount);
 }
 
 #endif
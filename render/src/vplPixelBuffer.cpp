@@ -70,4 +70,23 @@ namespace vpl
 
         vplMemFill(buffer_->getMemory(),c,pitch_*height_);
     }
+
+	void PixelBuffer::clear(const Color& color,const Rect& rect)
+    {
+        Rect area(0.0f,static_cast<float>(width_),static_cast<float>(height_),0.0f);
+
+        area.intersect(rect);
+
+        if(area.isEmpty())
+            return;
+
+        vplUint32 c = preMultiplyColorRGBA(color.getColorRGBA());
+
+        vplUint left = static_cast<vplUint>(area.left_);
+        vplUint count = static_cast<vplUint>(area.right_) - left;
+
+        for(vplUint y = static_cast<vplUint>(area.bottom_);
+            y < static_cast<vplUint>(area.top_); y++)
+            vplMemFill32(buffer_->getMemory() + y*pitch_ + left,c,count);
+    }
 }
\ No newline at end of file
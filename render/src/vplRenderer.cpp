@@ -17,6 +17,7 @@
 
 #include "vplConfig.h"
 #include "vplAffineMatrix.h"
+#include "vplBandRenderer.h"
 #include "vplEdgeGenerator.h"
 #include "vplFill.h"
 
@@ -25,12 +26,15 @@ namespace vpl
 	Renderer::Renderer():width_(0),height_(0),
 		                 maxCoverage_(cFullSubCoverage8),target_(0),
                          subPixelCount_(8),subPixelShift_(3),
-                         targetUpdated_(false),transformUpdated_(false)
+                         transformUpdated_(false),firstNewReference_(0),
+                         numRemovedReferences_(0)
     {
+        resetStatistics();
+
         edgeGenerator_ = new EdgeGenerator();
-        evenOddMaskBuffer_ = new EvenOddMaskBuffer();
-        nonZeroMaskBuffer_ = new NonZeroMaskBuffer();
+        fillState_ = new FillState();
         fillParameters_ = new FillParameters();
+        bandRenderer_ = new BandRenderer();
     }
 
 	Renderer::~Renderer()
@@ -39,9 +43,9 @@ namespace vpl
 		clearPaths();
 
         delete edgeGenerator_;
-        delete evenOddMaskBuffer_;
-        delete nonZeroMaskBuffer_;
+        delete fillState_;
         delete fillParameters_;
+        delete bandRenderer_;
     }
 
 	void Renderer::setTarget(PixelBuffer* pixelBuffer)
@@ -55,6 +59,12 @@ namespace vpl
     {
         switch(sampling)
         {
+            case cSampleArea:
+                subPixelCount_ = 64;
+                subPixelShift_ = 6;
+                maxCoverage_   = 0;
+                break;
+
             case cSample32:
                 subPixelCount_ = 32;
                 subPixelShift_ = 5;
@@ -79,6 +89,14 @@ namespace vpl
             initialize();
     }
 
+    void Renderer::setNumberOfThreads(vplUint numThreads)
+    {
+        if(numThreads == 0)
+            numThreads = Thread::getNumberOfProcessors();
+
+        bandRenderer_->setNumberOfThreads(numThreads);
+    }
+
 	void Renderer::initialize()
     {
 		// Initalize
@@ -96,6 +114,8 @@ namespace vpl
                                    static_cast<float>(width_),
                                    static_cast<float>(height_));
 
+        // Edges depend on size and sampling
+        transformUpdated_ = true;
     }
 
     void Renderer::setClipRect(const Rect& rect)
@@ -156,8 +176,9 @@ namespace vpl
 		// Store path
 		ref->path_ = path;
 
-		// Insert for future use
-        newReferences_.insert(ref);
+		// Insert for future use, on top of everything else
+        ref->slot_ = references_.getItemCount();
+        references_.add(ref);
 
 		return ref;
 	}
@@ -178,50 +199,40 @@ namespace vpl
 	// Use reference to remove path
     void Renderer::removePath(PathReference** reference)
 	{
+        // Uncover what the path was drawn over
+        damage_.unite((*reference)->bounds_);
+
 		deAllocateReference(*reference);
 
-		references_.remove(*reference);
-        newReferences_.remove(*reference);
+        // Leave a hole, draw closes it
+		references_[(*reference)->slot_] = 0;
+        numRemovedReferences_++;
 
 		delete *reference;
 
 		*reference = 0;
 
-		targetUpdated_ = true;
 	}
 
 	void Renderer::clearPaths()
 	{
 		// Iterate and clean up all allocated data
-		ListIterator<PathReference*> it;
-
-		it.begin(references_);
-
-		while(!it.atLast())
-		{
-			deAllocateReference(*it);
-
-			delete *it;
-
-			++it;
-		}
-
-        // Paranoia?
-        it.begin(newReferences_);
-
-		while(!it.atLast())
+		for(vplUint i = 0; i < references_.getItemCount(); i++)
 		{
-			deAllocateReference(*it);
+            if(!references_[i])
+                continue;
 
-			delete *it;
+			deAllocateReference(references_[i]);
 
-			++it;
+			delete references_[i];
 		}
 
 		references_.clear();
-        newReferences_.clear();
+        firstNewReference_ = 0;
+        numRemovedReferences_ = 0;
 
-        targetUpdated_ = true;
+        damage_ = Rect(0.0f,static_cast<float>(width_),
+                       static_cast<float>(height_),0.0f);
 	}
     
 	void Renderer::compose(const PixelBuffer& src,BlendMode blendMode,
@@ -266,117 +277,242 @@ namespace vpl
         composeBuffers(blendMode,target_,src,destRect);
 	}
 
-	void Renderer::generateEdges(PathReference* reference)
-	{
+    AffineMatrix Renderer::computeEdgeTransform() const
+    {
         // Apply renderer transform and subpixeltransform
         AffineMatrix matrix = transform_;
 
         // The sampling point for the sub-pixel is at the top right corner. This
         // adjustment moves it to the pixel center
         matrix.scale(1.0f,static_cast<float>(subPixelCount_));
-        matrix.translate(0.5f/subPixelCount_,0.5f);
-        
+
+        // Area coverage has no sampling points
+        if(subPixelCount_ != cSampleArea)
+            matrix.translate(0.5f/subPixelCount_,0.5f);
+
+        return matrix;
+    }
+
+	void Renderer::generateEdges(PathReference* reference)
+	{
+        AffineMatrix matrix = computeEdgeTransform();
+
         // Save for stroker
         reference->externalTransform_ = matrix;
-        
-        // Generate points
-        reference->generator_->generatePoints(*reference->path_,matrix);
+
+        reference->edgeTransform_ = reference->path_->getTransform();
+        reference->edgeTransform_ *= matrix;
+
+        // Generate points, flatten only if the path changed or the old
+        // points do not fit the new transform
+        reference->generator_->setVerticalScale(static_cast<float>(subPixelCount_));
+
+        if(!reference->pointsValid_ ||
+           !reference->generator_->reusePoints(*reference->path_,matrix))
+            reference->generator_->generatePoints(*reference->path_,matrix);
+
+        reference->pointsValid_ = true;
 
         // Generate edges
         edgeGenerator_->generateEdges(reference);
 
-        // Update path
-        reference->path_->segmentsValid_ = true;
+        statistics_.numPaths_++;
+
+        if(reference->fillEdges_)
+            statistics_.numEdges_ += reference->fillEdges_->getNumberOfEdges();
+
+        if(reference->strokeEdges_)
+            statistics_.numEdges_ += reference->strokeEdges_->getNumberOfEdges();
+
+        // Update path, paths that did not change are left alone so
+        // renderers on other threads can share them
+        if(!reference->path_->segmentsValid_)
+            reference->path_->segmentsValid_ = true;
+        reference->edgesValid_ = true;
 	}
 
-    // See if we need to regenerate paths
+    // Move the paths left down over the holes of removed ones, in order
+    void Renderer::compactReferences()
+    {
+        if(numRemovedReferences_ == 0)
+            return;
+
+        vplUint count = 0;
+        vplUint firstNew = 0;
+
+        for(vplUint i = 0; i < references_.getItemCount(); i++)
+        {
+            if(!references_[i])
+                continue;
+
+            if(i < firstNewReference_)
+                firstNew++;
+
+            references_[i]->slot_ = count;
+            references_[count++] = references_[i];
+        }
+
+        references_.resize(count);
+        firstNewReference_ = firstNew;
+        numRemovedReferences_ = 0;
+    }
+
+    // Regenerate the edges of paths that changed and collect the
+    // area they were and are drawn in
 	void Renderer::updatePathEdges()
 	{
+        AffineMatrix matrix = computeEdgeTransform();
+
         // Iterate over all path references
-		ListIterator<PathReference*> it;
+		for(vplUint i = 0; i < firstNewReference_; i++)
+		{
+            PathReference* reference = references_[i];
+
+            AffineMatrix edgeTransform = reference->path_->getTransform();
+            edgeTransform *= matrix;
+
+            if(!reference->path_->segmentsValid_ || transformUpdated_ ||
+               edgeTransform != reference->edgeTransform_)
+                reference->edgesValid_ = false;
 
-		it.begin(references_);
+            if(!reference->path_->segmentsValid_)
+                reference->pointsValid_ = false;
+		}
+
+        // Everything moves when the target, sampling or clipping changes
+        if(transformUpdated_)
+            damage_ = Rect(0.0f,static_cast<float>(width_),
+                           static_cast<float>(height_),0.0f);
 
-		while(!it.atLast())
+        // Paths can be shared, so regenerate once all are marked
+		for(vplUint i = 0; i < firstNewReference_; i++)
 		{
-            if(!(*it)->path_->segmentsValid_ || transformUpdated_)
-			    targetUpdated_ = true;
+            PathReference* reference = references_[i];
+
+            if(!reference->edgesValid_)
+            {
+                damage_.unite(reference->bounds_);
 
-			++it;
+                generateEdges(reference);
+
+                damage_.unite(reference->bounds_);
+            }
 		}
 
 		transformUpdated_ = false;
 	}
-	// Choose correct fill function
+	// Fill now or queue for band rendering
     void Renderer::fill(BlendMode blendMode,Brush::FillMode fillMode,vplUint32 color,
 				        Gradient* gradient,ScanLineList* scanLines)
     {
-        if(fillMode == Brush::cEvenOdd)
-		{
-            if(gradient)
-			{
-                gradientFillEvenOdd(blendMode,target_,scanLines,gradient,
-					                *fillParameters_,evenOddMaskBuffer_);
-			}
-			else
-			{
-                fillEvenOdd(blendMode,target_,scanLines,color,
-					        *fillParameters_,evenOddMaskBuffer_);
-			}
-		}
-		else
-		{
-			if(gradient)
-			{
-                gradientFillNonZero(blendMode,target_,scanLines,gradient,
-					                *fillParameters_,nonZeroMaskBuffer_);
-			}
-			else
-			{
-				fillNonZero(blendMode,target_,scanLines,color,
-					        *fillParameters_,nonZeroMaskBuffer_);
-			}
-		}
+        // The color table is built here, fills only read the gradient
+        if(gradient)
+            gradient->validate();
+
+        statistics_.numFills_++;
+        statistics_.numFilledEdges_ += scanLines->getNumberOfEdges();
+
+        FillJob job;
+
+        job.blendMode_ = blendMode;
+        job.fillMode_ = fillMode;
+        job.color_ = color;
+        job.gradient_ = gradient;
+        job.edges_ = scanLines;
+
+        if(bandRenderer_->getNumberOfThreads() > 1)
+            bandRenderer_->add(job,*fillParameters_);
+        else
+            fillPath(job,target_,*fillParameters_,fillState_);
+    }
+
+    void Renderer::drawReference(PathReference* reference)
+    {
+        // Fill
+        if(reference->fillEdges_)
+        {
+            fill(reference->brush_.getBlendMode(),
+                 reference->brush_.getFillMode(),
+                 preMultiplyColorRGBA(reference->brush_.getColorAsRGBA()),
+                 reference->brush_.getGradient(),
+                 reference->fillEdges_);
+        }
+
+        // Stroke
+        if(reference->strokeEdges_)
+        {
+            fill(reference->pen_.getBlendMode(),
+                 Brush::cNonZero,
+                 preMultiplyColorRGBA(reference->pen_.getColorAsRGBA()),
+                 reference->pen_.getGradient(),
+                 reference->strokeEdges_);
+        }
     }
 
     void Renderer::drawNewEdges()
     {
-        ListIterator<PathReference*> it;
+        for(vplUint i = firstNewReference_; i < references_.getItemCount(); i++)
+        {
+            generateEdges(references_[i]);
+
+            drawReference(references_[i]);
+        }
+
+        // Drawn, so they are old from now on
+        firstNewReference_ = references_.getItemCount();
+    }
+
+    // Clear the damaged area and draw the paths over it again, clipped to it
+    void Renderer::repaintDamage()
+    {
+        Rect area(0.0f,static_cast<float>(width_),static_cast<float>(height_),0.0f);
 
-		it.begin(newReferences_);
+        area.intersect(damage_);
 
-		while(!it.atLast())
+        damage_ = Rect();
+
+        if(area.isEmpty())
+            return;
+
+        target_->clear(cWhite,area);
+
+        setFillArea(area);
+
+        for(vplUint i = 0; i < firstNewReference_; i++)
         {
-             generateEdges(*it);
-
-            // Fill
-			if((*it)->fillEdges_)
-			{
-                fill((*it)->brush_.getBlendMode(),
-					 (*it)->brush_.getFillMode(),
-					 preMultiplyColorRGBA((*it)->brush_.getColorAsRGBA()),
-					 (*it)->brush_.getGradient(),
-					 (*it)->fillEdges_);
-			}
-
-			// Stroke
-			if((*it)->strokeEdges_)
-			{
-				fill((*it)->pen_.getBlendMode(),
-					 Brush::cNonZero,
-					 preMultiplyColorRGBA((*it)->pen_.getColorAsRGBA()),
-					 (*it)->pen_.getGradient(),
-					 (*it)->strokeEdges_);
-			}
-
-            // Add to references
-            references_.insert((*it));
-
-            // Move to next
-			++it;
+            if(references_[i]->bounds_.intersects(area))
+                drawReference(references_[i]);
         }
 
-        newReferences_.clear();
+        flushBands();
+    }
+
+    void Renderer::setFillArea(const Rect& area)
+    {
+        fillParameters_->firstLine_ = static_cast<int>(area.bottom_);
+        fillParameters_->lastLine_ = static_cast<int>(area.top_) - 1;
+        fillParameters_->firstColumn_ = static_cast<int>(area.left_);
+        fillParameters_->lastColumn_ = static_cast<int>(area.right_) - 1;
+    }
+
+    void Renderer::invalidate(const Rect& area)
+    {
+        damage_.unite(area);
+    }
+
+    void Renderer::resetStatistics()
+    {
+        statistics_.numPaths_ = 0;
+        statistics_.numEdges_ = 0;
+        statistics_.numFills_ = 0;
+        statistics_.numFilledEdges_ = 0;
+    }
+
+    // Fill queued edges in bands
+    void Renderer::flushBands()
+    {
+        if(bandRenderer_->getNumberOfThreads() > 1)
+            bandRenderer_->render(target_,*fillParameters_,fillState_);
     }
 
     void Renderer::draw()
@@ -387,49 +523,31 @@ namespace vpl
 		fillParameters_->maxCoverage_ = maxCoverage_;
 		fillParameters_->subPixelShift_ = subPixelShift_;
 		fillParameters_->subPixelCount_ = subPixelCount_;
+        fillParameters_->areaCoverage_ = subPixelCount_ == cSampleArea;
+
+        // Mask generators for this sampling
+        fillState_->setSubPixelCount(subPixelCount_);
+
+        resetStatistics();
+
+        // Close the holes of removed paths
+        compactReferences();
 
 		// Do we need to update edges?
 		updatePathEdges();
 
-		// Do we need to update target?
-		if(targetUpdated_)
-		{
-            // Clear and draw all "old" paths
-			target_->clear(cWhite);
-
-			ListIterator<PathReference*> it;
-
-			it.begin(references_);
-
-			while(!it.atLast())
-			{
-                generateEdges(*it);
-
-				// Fill
-				if((*it)->fillEdges_)
-				{
-					 fill((*it)->brush_.getBlendMode(),
-					      (*it)->brush_.getFillMode(),
-					      preMultiplyColorRGBA((*it)->brush_.getColorAsRGBA()),
-					      (*it)->brush_.getGradient(),
-					      (*it)->fillEdges_);
-				}
-
-				// Stroke
-				if((*it)->strokeEdges_)
-				{
-					fill((*it)->pen_.getBlendMode(),
-					     Brush::cNonZero,
-					     preMultiplyColorRGBA((*it)->pen_.getColorAsRGBA()),
-					     (*it)->pen_.getGradient(),
-					     (*it)->strokeEdges_);
-				}
-				// Move to next
-				++it;
-            }
-        }
-        // Draw the new edges
+        // Draw the old paths where something changed
+        repaintDamage();
+
+        // New paths are drawn on top of everything, over the whole target
+        fillParameters_->firstLine_ = 0;
+        fillParameters_->lastLine_ = static_cast<int>(height_) - 1;
+        fillParameters_->firstColumn_ = 0;
+        fillParameters_->lastColumn_ = static_cast<int>(width_) - 1;
+
         drawNewEdges();
+
+        flushBands();
 	}
 
 }
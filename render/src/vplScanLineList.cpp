@@ -23,102 +23,97 @@ namespace vpl
 	 // Scanline list implementation
     ScanLineList::~ScanLineList()
     {
-        // Delete edge storage
-		for(vplUint i = 0; i < allEdges_.getItemCount();i++)
-			delete [] allEdges_[i];
+        if(edges_)
+            delete [] edges_;
 
-        if(scanLines_)
-            delete [] scanLines_;
+        if(lineStarts_)
+            delete [] lineStarts_;
     }
-    void ScanLineList::init(vplUint numLines,vplUint numEdges,vplUint numSubPixels)
+    void ScanLineList::init(vplUint numLines,vplUint numSubPixels)
     {
-        // Clear old edges
-        for(vplUint i = 0; i < allEdges_.getItemCount();i++)
-			delete [] allEdges_[i];
-
-		allEdges_.clear();
-
-        if(scanLines_)
-            delete [] scanLines_;
-
-        numAllocatedEdges_ = numEdges;
         numSubPixels_ = numSubPixels;
         numScanLines_ = numLines + 1;
-        edgeCount_ = 0;
+
+        clear();
+    }
+	void ScanLineList::clear()
+	{
+		totalEdgeCount_ = 0;
         maxY_ = INT_MIN;
         minY_ = INT_MAX;
+	}
+    // Counting sort on the first scanline, edges on the same line keep
+    // their order
+    void ScanLineList::setEdges(const Edge* edges,vplUint count)
+    {
+        clear();
 
-        // Allocate new space
-        edges_ = new Edge[numAllocatedEdges_];
-        scanLines_ = new Edge*[numScanLines_];
+        if(count == 0)
+            return;
 
-		allEdges_.add(edges_);
+        // Range of lines, take subpixels into account
+        for(vplUint i = 0; i < count; i++)
+        {
+            int firstLine = edges[i].firstScanLine_ / static_cast<int>(numSubPixels_);
+            int lastLine  = edges[i].lastScanLine_ / static_cast<int>(numSubPixels_);
 
-		vplMemFill(scanLines_,(Edge*)0x0,numScanLines_);
-    }
-	void ScanLineList::clear()
-	{
-		 // Clear old edges
-        for(vplUint i = 1; i < allEdges_.getItemCount();i++)
-			delete [] allEdges_[i];
+            if(firstLine < minY_)
+                minY_ = firstLine;
 
-		// Save first edge chunk
-		Edge* initialEdges = allEdges_[0];
+            if(lastLine > maxY_)
+                maxY_ = lastLine;
+        }
 
-		// Clear and add initial
-		allEdges_.clear();
-		allEdges_.add(initialEdges);
+        vplUint numLines = static_cast<vplUint>(maxY_ - minY_) + 2;
 
-		// Reset counter and scanline pointers
-		edgeCount_ = 0;
+        // Only grow the storage, lines at once to the full height and
+        // edges with room to spare for paths that change a little
+        if(numLines > numAllocatedLines_)
+        {
+            if(lineStarts_)
+                delete [] lineStarts_;
 
-		vplMemFill(scanLines_,(Edge*)0x0,numScanLines_);
-	}
-    // Insert edge into scanline list
-	void ScanLineList::insert(const Edge& edge)
-    {
-		// Get scanlines, take subpixels into account
-		int firstLine = edge.firstScanLine_/ numSubPixels_;
-		int lastLine  = edge.lastScanLine_ / numSubPixels_;
+            if(numLines < numScanLines_ + 1)
+                numAllocatedLines_ = numScanLines_ + 1;
+            else
+                numAllocatedLines_ = numLines;
 
-		// Add to scan line list
-		edges_[edgeCount_] = edge;
+            lineStarts_ = new vplUint[numAllocatedLines_];
+        }
 
-        if(scanLines_[firstLine] == 0)
-            scanLines_[firstLine] = &edges_[edgeCount_];
-        else
-            scanLines_[firstLine]->insert(&edges_[edgeCount_]);
+        if(count > numAllocatedEdges_)
+        {
+            if(edges_)
+                delete [] edges_;
 
-        edgeCount_++;
+            numAllocatedEdges_ = count + count/4;
+            edges_ = new Edge[numAllocatedEdges_];
+        }
 
-        if(edgeCount_ == numAllocatedEdges_)
-            resizeEdgeStorage();
+        // Count the edges of each line one step ahead, the sums are
+        // then where each line starts
+        vplMemFill(lineStarts_,static_cast<vplUint>(0),numLines);
 
-		// See if we need to update min/max
-		if(firstLine < minY_)
-	        minY_ = firstLine;
+        for(vplUint i = 0; i < count; i++)
+            lineStarts_[edges[i].firstScanLine_ / static_cast<int>(numSubPixels_) - minY_ + 1]++;
 
-        if(lastLine > maxY_)
-            maxY_ = lastLine;
+        for(vplUint i = 1; i < numLines; i++)
+            lineStarts_[i] += lineStarts_[i - 1];
 
-    }
-    void ScanLineList::resizeEdgeStorage()
-    {
-		// Allocate new storage
-        Edge* newEdges = new Edge[numAllocatedEdges_];
+        // Placing an edge moves the start of its line one step, after
+        // all are placed every line starts where the next one did
+        for(vplUint i = 0; i < count; i++)
+        {
+            int line = edges[i].firstScanLine_ / static_cast<int>(numSubPixels_) - minY_;
 
-		// Update pointer
-        edges_ = newEdges;
+            edges_[lineStarts_[line]++] = edges[i];
+        }
 
-		// Store new pointer
-		allEdges_.add(newEdges);
+        for(vplUint i = numLines - 1; i > 0; i--)
+            lineStarts_[i] = lineStarts_[i - 1];
 
-		//Reset index counter
-		edgeCount_ = 0;
-    }
-    // Return edges in a scanline
-    Edge* ScanLineList::getLine(int line)
-    {
-        return scanLines_[line];
+        lineStarts_[0] = 0;
+
+        totalEdgeCount_ = count;
     }
-}
\ No newline at end of file
+}
@@ -25,28 +25,41 @@
 
 namespace vpl
 {
+    // Edges sorted by the scanline they start on. All edges are kept in
+    // one array, the edges of a scanline are next to each other so a
+    // fill reads them in order.
 	class VPL_API ScanLineList
     {
     public:
-        ScanLineList():edges_(0),scanLines_(0),numSubPixels_(0),
-                       edgeCount_(0),numAllocatedEdges_(0),
-                       numScanLines_(0),maxY_(INT_MIN),minY_(INT_MAX){}
+        ScanLineList():edges_(0),lineStarts_(0),numSubPixels_(0),
+                       totalEdgeCount_(0),numAllocatedEdges_(0),
+                       numScanLines_(0),numAllocatedLines_(0),
+                       maxY_(INT_MIN),minY_(INT_MAX){}
 
         ~ScanLineList();
 
-        // Set initial size
-        void init(vplUint numLines,vplUint numEdges,vplUint numSubPixels);
+        // Set size, storage from earlier use is kept and reused
+        // when it is large enough
+        void init(vplUint numLines,vplUint numSubPixels);
 
-        // Clear the list, this will delete all arrays
-        // that have been added by resizing and
-        // clear the initial array
+        // Remove all edges but keep the storage
         void clear();
 
-        // Edges inserted have scanlines in subpixels
-        void insert(const Edge& edge);
+        // Replace the edges with count edges, in any order. Scanlines
+        // of the edges are in subpixels
+        void setEdges(const Edge* edges,vplUint count);
 
-        // Getters
-        Edge* getLine(int line);
+        // Edges starting on a line from getMin() to getMax(), they
+        // end where the edges of the next line start
+        inline const Edge* getLine(int line) const
+        {
+            return edges_ + lineStarts_[line - minY_];
+        }
+
+        inline const Edge* getLineEnd(int line) const
+        {
+            return edges_ + lineStarts_[line - minY_ + 1];
+        }
 
         inline int getMax() 
 		{
@@ -60,7 +73,7 @@ namespace vpl
 
 		inline vplUint getNumberOfEdges()     
 		{
-			return edgeCount_; 
+			return totalEdgeCount_; 
 		}
         
 		inline vplUint getNumberOfScanLines() 
@@ -75,18 +88,18 @@ namespace vpl
 
     private:
 
-        void resizeEdgeStorage();
-
-        Edge*  edges_;
-        Edge** scanLines_;
-        DynamicArray<Edge*> allEdges_;
+        Edge* edges_;
+        // Index of the first edge of each line from minY_ and one past
+        // the last line
+        vplUint* lineStarts_;
         vplUint numSubPixels_;
-        vplUint edgeCount_;
+        vplUint totalEdgeCount_;
         vplUint numAllocatedEdges_;
         vplUint numScanLines_;
+        vplUint numAllocatedLines_;
         int  maxY_;
         int  minY_;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
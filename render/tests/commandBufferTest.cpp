@@ -0,0 +1,220 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Command buffer checks, returns non zero when one fails
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include "vplCommandBuffer.h"
+
+// Words before the first stop offset of a buffer that starts with a
+// gradient: the buffer header, the command header and the gradient
+// up to its stop count
+static const vplUint cFirstStopOffset = 2 + 2 + 9;
+
+static int failures = 0;
+
+static void check(bool condition,const char* what)
+{
+    if(!condition)
+    {
+        printf("FAILED: %s\n",what);
+        failures++;
+    }
+}
+
+static vplUint32 toWord(float value)
+{
+    vplUint32 word;
+
+    std::memcpy(&word,&value,sizeof(word));
+
+    return word;
+}
+
+static float toFloat(vplUint32 word)
+{
+    float value;
+
+    std::memcpy(&value,&word,sizeof(value));
+
+    return value;
+}
+
+static unsigned long long hashTarget(const vpl::PixelBuffer& target)
+{
+    unsigned long long hash = 1469598103934665603ULL;
+    const vplUint32* pixels = target.getBuffer();
+
+    for(vplUint i = 0; i < target.getWidth()*target.getHeight(); i++)
+    {
+        hash ^= pixels[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+// Copy of the data of buffer with the first stop offset replaced
+static bool setDataWithOffset(const vpl::CommandBuffer& buffer,float offset)
+{
+    vpl::DynamicArray<vplUint32> words;
+
+    words.add(buffer.getData(),buffer.getSize());
+    words[cFirstStopOffset] = toWord(offset);
+
+    vpl::CommandBuffer patched;
+
+    bool accepted = patched.setData(words.getContents(),words.getItemCount());
+
+    check(accepted || patched.getSize() == 2,"rejected buffer is left empty");
+
+    return accepted;
+}
+
+static void testStopOffsets()
+{
+    vpl::Path path;
+    vpl::LinearGradient gradient(0.0f,0.0f,100.0f,0.0f);
+    vpl::Brush brush;
+
+    vpl::drawRect(path,10.0f,10.0f,80.0f,80.0f);
+
+    gradient.addStop(0.2f,vpl::cBlue);
+    gradient.addStop(0.8f,vpl::cRed);
+    brush.setGradient(&gradient);
+
+    vpl::CommandBuffer buffer;
+
+    buffer.addPath(&path,&brush);
+    buffer.draw();
+
+    check(toFloat(buffer.getData()[cFirstStopOffset]) == 0.2f,"first stop offset position");
+
+    vpl::CommandBuffer copy;
+
+    check(copy.setData(buffer.getData(),buffer.getSize()),"round trip of a valid buffer");
+    check(copy.getSize() == buffer.getSize(),"round trip keeps every word");
+
+    check(setDataWithOffset(buffer,0.0f),"stop offset 0 is accepted");
+    check(!setDataWithOffset(buffer,5.0f),"stop offset above 1 is rejected");
+    check(!setDataWithOffset(buffer,-0.5f),"negative stop offset is rejected");
+    check(!setDataWithOffset(buffer,0.9f),"stops out of order are rejected");
+    check(!setDataWithOffset(buffer,std::numeric_limits<float>::quiet_NaN()),
+          "NaN stop offset is rejected");
+    check(!setDataWithOffset(buffer,std::numeric_limits<float>::infinity()),
+          "infinite stop offset is rejected");
+}
+
+static void testAddStop()
+{
+    vpl::LinearGradient gradient(0.0f,0.0f,100.0f,0.0f);
+
+    gradient.addStop(5.0f,vpl::cRed);
+    gradient.addStop(std::numeric_limits<float>::quiet_NaN(),vpl::cGreen);
+    gradient.addStop(-1.0f,vpl::cBlue);
+    gradient.addStop(0.5f,vpl::cBlack);
+
+    vpl::Gradient::Stop* stops = gradient.getStops();
+
+    check(gradient.getNumberOfStops() == 4,"every stop is added");
+    check(stops[0].offset_ == 0.0f && stops[1].offset_ == 0.0f,"offsets are clamped to 0");
+    check(stops[2].offset_ == 0.5f,"stops are kept in order");
+    check(stops[3].offset_ == 1.0f,"offsets are clamped to 1");
+
+    // A buffer recording it can be read back
+    vpl::Path path;
+    vpl::Brush brush;
+
+    vpl::drawRect(path,10.0f,10.0f,80.0f,80.0f);
+    brush.setGradient(&gradient);
+
+    vpl::CommandBuffer buffer;
+    vpl::CommandBuffer copy;
+
+    buffer.addPath(&path,&brush);
+
+    check(copy.setData(buffer.getData(),buffer.getSize()),"clamped stops round trip");
+}
+
+static void testChangedGradient()
+{
+    vpl::Path path;
+    vpl::LinearGradient gradient(0.0f,0.0f,40.0f,0.0f);
+    vpl::Brush brush;
+
+    vpl::drawRect(path,0.0f,0.0f,100.0f,100.0f);
+
+    gradient.addStop(0.0f,vpl::cBlue);
+    gradient.addStop(1.0f,vpl::cRed);
+    brush.setGradient(&gradient);
+
+    vpl::PixelBuffer direct;
+    vpl::PixelBuffer replayed;
+    vpl::Renderer renderer;
+    vpl::CommandBuffer buffer;
+
+    direct.initialize(100,100);
+    replayed.initialize(100,100);
+    direct.clear(vpl::cWhite);
+    replayed.clear(vpl::cWhite);
+
+    renderer.setTarget(&direct);
+
+    // Same gradient twice, recorded once
+    buffer.addPath(&path,&brush);
+    vplUint size = buffer.getSize();
+    buffer.addPath(&path,&brush);
+
+    check(buffer.getSize() - size == size - 2 - (2 + 9 + 2*2),
+          "unchanged gradient is not recorded again");
+
+    buffer.clearPaths();
+
+    // Changed after it was recorded
+    gradient.setSpread(vpl::Gradient::cRepeat);
+
+    buffer.addPath(&path,&brush);
+    buffer.draw();
+
+    renderer.addPath(&path,&brush);
+    renderer.draw();
+
+    vpl::Renderer replayer;
+
+    replayer.setTarget(&replayed);
+    buffer.replay(replayer);
+
+    check(hashTarget(direct) == hashTarget(replayed),"changed gradient is replayed");
+
+    replayer.clearPaths();
+    renderer.clearPaths();
+}
+
+int main()
+{
+    testStopOffsets();
+    testAddStop();
+    testChangedGradient();
+
+    if(failures == 0)
+        printf("All command buffer tests passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
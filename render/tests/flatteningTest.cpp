@@ -0,0 +1,86 @@
+/* VPL - Vector path library
+ * Copyright (C) 2009 - 2011 Mattias Sahln <mattias.sahlen@gmail.com>
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General General Public License for more details.
+ *
+ * You should have received a copy of the GNU General General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Curve flattening checks, returns non zero when one fails
+
+#include <cstdio>
+#include "vplRender.h"
+
+static int failures = 0;
+
+static void check(bool condition,const char* what)
+{
+    if(!condition)
+    {
+        printf("FAILED: %s\n",what);
+        failures++;
+    }
+}
+
+// Edges of a closed shape of two cubics drawn with the given sampling
+static vplUint countEdges(vpl::Renderer::Sampling sampling)
+{
+    vpl::Path path;
+    vpl::Brush brush;
+    vpl::PixelBuffer target;
+    vpl::Renderer renderer;
+
+    path.moveToAbs(20.0f,150.0f);
+    path.cubicBezierToAbs(280.0f,150.0f,60.0f,20.0f,240.0f,20.0f);
+    path.cubicBezierToAbs(20.0f,150.0f,240.0f,280.0f,60.0f,280.0f);
+    path.closePath();
+    path.setFlattening(vpl::Path::cAnalytic,0.125f);
+
+    target.initialize(300,300);
+
+    renderer.setSamplingValue(sampling);
+    renderer.setTarget(&target);
+    renderer.addPath(&path,&brush);
+    renderer.draw();
+
+    vplUint numEdges = renderer.getStatistics().numEdges_;
+
+    renderer.clearPaths();
+
+    return numEdges;
+}
+
+// The tolerance is in device units, the sub pixel rows of the sampling
+// must not add steps
+static void testSamplingIndependence()
+{
+    vplUint edges8 = countEdges(vpl::Renderer::cSample8);
+    vplUint edges16 = countEdges(vpl::Renderer::cSample16);
+    vplUint edges32 = countEdges(vpl::Renderer::cSample32);
+    vplUint edgesArea = countEdges(vpl::Renderer::cSampleArea);
+
+    check(edges8 > 2,"curves are flattened");
+    check(edges16 == edges8,"cSample16 steps as cSample8");
+    check(edges32 == edges8,"cSample32 steps as cSample8");
+    check(edgesArea == edges8,"cSampleArea steps as cSample8");
+}
+
+int main()
+{
+    testSamplingIndependence();
+
+    if(failures == 0)
+        printf("All flattening tests passed\n");
+
+    return failures == 0 ? 0 : 1;
+}